@@ -0,0 +1,39 @@
+# Finds the ZeroMQ includes and library
+#
+# This module defines
+# - ZMQ_INCLUDE_DIRS, where to find zmq.h.
+# - ZMQ_LIBRARIES, the libraries needed to use ZeroMQ.
+# - ZMQ_FOUND, If false, do not try to use ZeroMQ.
+
+FIND_PATH(ZMQ_INCLUDE_DIRS zmq.h
+    /usr/include
+    /usr/local/include
+)
+
+FIND_LIBRARY(ZMQ_LIBRARIES
+    NAMES
+    zmq
+    PATHS
+    /usr/lib
+    /usr/local/lib
+)
+
+IF(ZMQ_INCLUDE_DIRS AND ZMQ_LIBRARIES)
+    SET(ZMQ_FOUND TRUE)
+ENDIF(ZMQ_INCLUDE_DIRS AND ZMQ_LIBRARIES)
+
+
+IF(ZMQ_FOUND)
+   IF(NOT ZMQ_FIND_QUIETLY)
+      MESSAGE(STATUS "Found ZeroMQ: ${ZMQ_LIBRARIES}")
+   ENDIF(NOT ZMQ_FIND_QUIETLY)
+ELSE(ZMQ_FOUND)
+   IF(ZMQ_FIND_REQUIRED)
+      MESSAGE(FATAL_ERROR "Could not find ZeroMQ library include: ${ZMQ_INCLUDE_DIRS}, lib: ${ZMQ_LIBRARIES}")
+   ENDIF(ZMQ_FIND_REQUIRED)
+ENDIF(ZMQ_FOUND)
+
+MARK_AS_ADVANCED(
+    ZMQ_INCLUDE_DIRS
+    ZMQ_LIBRARIES
+)
@@ -0,0 +1,96 @@
+/**
+ * @file    hex.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Throughput of the hex conversion routines compared to a
+ * plain byte-at-a-time loop, for txid sized, transaction
+ * sized and block sized inputs.
+ */
+
+#include <raptoreumapi/hex.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static void referenceEncode(const unsigned char * data, size_t len, char * out){
+	static const char digits[] = "0123456789abcdef";
+	for(size_t i = 0; i < len; ++i){
+		out[2 * i] = digits[data[i] >> 4];
+		out[2 * i + 1] = digits[data[i] & 0x0F];
+	}
+}
+
+static bool referenceDecode(const char * hex, size_t len, unsigned char * out){
+	for(size_t i = 0; i < len; ++i){
+		unsigned char b = 0;
+		for(int j = 0; j < 2; ++j){
+			char c = hex[2 * i + j];
+			int v = (c >= '0' && c <= '9') ? c - '0'
+			      : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+			      : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+			if(v < 0){
+				return false;
+			}
+			b = (unsigned char) ((b << 4) | v);
+		}
+		out[i] = b;
+	}
+	return true;
+}
+
+/* Runs f until about 100 MB went through, returns MB/s of binary data */
+template<typename F>
+static double measure(size_t len, F f){
+	size_t rounds = 100000000 / len + 1;
+	Clock::time_point start = Clock::now();
+	for(size_t i = 0; i < rounds; ++i){
+		f();
+	}
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	return (double) rounds * len / seconds / 1e6;
+}
+
+int main(){
+	const size_t sizes[] = { 32, 250, 4096, 1 << 20 };
+	volatile bool sink = false;
+
+	std::printf("kernel: %s\n", HexImplementation());
+	std::printf("%10s %14s %14s %14s %14s\n", "bytes", "encode MB/s", "ref encode", "decode MB/s", "ref decode");
+
+	for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s){
+		size_t len = sizes[s];
+		std::vector<unsigned char> data(len), back(len);
+		std::string hex(2 * len, '0');
+		for(size_t i = 0; i < len; ++i){
+			data[i] = (unsigned char) std::rand();
+		}
+		/* Timings of wrong results mean nothing */
+		std::string ref(2 * len, '0');
+		referenceEncode(&data[0], len, &ref[0]);
+		HexEncode(&data[0], len, &hex[0]);
+		if(hex != ref || !HexDecode(hex.data(), len, &back[0]) || back != data){
+			std::fprintf(stderr, "%s kernel differs from the reference at %zu bytes\n", HexImplementation(), len);
+			std::abort();
+		}
+
+		double enc = measure(len, [&](){ HexEncode(&data[0], len, &hex[0]); });
+		double encRef = measure(len, [&](){ referenceEncode(&data[0], len, &hex[0]); });
+		double dec = measure(len, [&](){ sink = HexDecode(hex.data(), len, &back[0]); });
+		double decRef = measure(len, [&](){ sink = referenceDecode(hex.data(), len, &back[0]); });
+		if(hex != ref || back != data){
+			std::fprintf(stderr, "%s kernel differs from the reference at %zu bytes\n", HexImplementation(), len);
+			std::abort();
+		}
+
+		std::printf("%10zu %14.0f %14.0f %14.0f %14.0f\n", len, enc, encRef, dec, decRef);
+	}
+
+	return sink ? 0 : 1;
+}
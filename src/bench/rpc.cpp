@@ -0,0 +1,197 @@
+/**
+ * @file    rpc.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Cost of RPC calls against the mock daemon over loopback:
+ * transport round trips and the decoding of the recorded
+ * responses in fixtures/, as time, allocations and bytes
+ * allocated per call on the calling thread.
+ */
+
+#include <mock/mockdaemon.h>
+#include <raptoreumapi/raptoreumapi.h>
+#include <raptoreumapi/exception.h>
+#include <raptoreumapi/jsonscanner.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifndef BENCH_FIXTURES
+#define BENCH_FIXTURES "fixtures"
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+/* === Allocation counting === */
+
+// Only the benchmarking thread counts, not the daemon's
+static thread_local bool counting = false;
+static thread_local unsigned long allocations = 0;
+static thread_local unsigned long allocated = 0;
+
+void * operator new(size_t size){
+	if(counting){
+		++allocations;
+		allocated += size;
+	}
+	void * p = std::malloc(size ? size : 1);
+	if(p == NULL){
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void * operator new[](size_t size){
+	return operator new(size);
+}
+
+void operator delete(void * p) noexcept{
+	std::free(p);
+}
+
+void operator delete[](void * p) noexcept{
+	std::free(p);
+}
+
+/* === Runner === */
+
+struct benchmark_t{
+	std::string name;
+	std::function<void()> run;
+};
+
+/* Doubles the iterations until a run takes minTime seconds, then reports
+   per call figures of that run */
+static void measure(const benchmark_t& benchmark, double minTime){
+	benchmark.run();
+
+	unsigned long iterations = 1;
+	while(true){
+		allocations = 0;
+		allocated = 0;
+		counting = true;
+		Clock::time_point start = Clock::now();
+		for(unsigned long i = 0; i < iterations; ++i){
+			benchmark.run();
+		}
+		double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		counting = false;
+
+		if(elapsed >= minTime || iterations >= 1000000000UL){
+			std::printf("%-36s %12.0f %12lu %12.1f %12.0f\n", benchmark.name.c_str(),
+			            elapsed * 1e9 / iterations, iterations,
+			            (double) allocations / iterations, (double) allocated / iterations);
+			return;
+		}
+
+		double next = iterations * minTime * 1.4 / std::max(elapsed, 1e-9);
+		iterations = std::max(iterations * 2, (unsigned long) std::min(next, 1e9));
+	}
+}
+
+/* Loads a recorded getrawtransaction response and also serves its hex for
+   verbose=0, returns the txid */
+static std::string loadTransaction(MockDaemon& daemon, const std::string& file){
+	std::ifstream in(file.c_str());
+	Json::Value root;
+	Json::Reader reader;
+
+	if(!in || !reader.parse(in, root)){
+		throw std::runtime_error("Cannot read " + file);
+	}
+	daemon.loadFixtures(file);
+
+	const Json::Value& entry = root["getrawtransaction"][0];
+	std::string txid = entry["params"][0].asString();
+	Json::Value params;
+	params.append(txid);
+	params.append(0);
+	daemon.setResponse("getrawtransaction", params, entry["result"]["hex"]);
+
+	return txid;
+}
+
+int main(int argc, char * argv[]){
+	std::string fixtures = BENCH_FIXTURES;
+	std::string filter;
+	double minTime = 0.5;
+
+	for(int i = 1; i < argc; ++i){
+		std::string arg = argv[i];
+		if(arg.compare(0, 10, "-fixtures=") == 0) fixtures = arg.substr(10);
+		else if(arg.compare(0, 10, "-min_time=") == 0) minTime = std::atof(arg.c_str() + 10);
+		else if(arg[0] != '-') filter = arg;
+		else{
+			std::fprintf(stderr, "Usage: raptoreumapi_bench [-fixtures=<dir>] [-min_time=<s>] [filter]\n");
+			return 1;
+		}
+	}
+
+	try{
+		MockDaemon daemon;
+		std::string small = loadTransaction(daemon, fixtures + "/rawtransaction_small.json");
+		std::string large = loadTransaction(daemon, fixtures + "/rawtransaction_1000in.json");
+		daemon.loadFixtures(fixtures + "/transaction.json");
+		daemon.loadFixtures(fixtures + "/mininginfo.json");
+
+		RaptoreumAPI btc("user", "password", "http://127.0.0.1", daemon.start());
+		volatile size_t sink = 0;
+
+		std::vector<benchmark_t> benchmarks = {
+			{ "SendCommand/getblockcount", [&](){
+				sink = btc.sendcommand("getblockcount", Json::Value()).asUInt();
+			} },
+			{ "SendCommandScanned/getblockcount", [&](){
+				btc.sendcommand("getblockcount", Json::Value(), [&](JsonScanner& scanner){
+					sink = scanner.readInt();
+				});
+			} },
+			{ "GetRawTransaction/small", [&](){
+				sink = btc.getRawTransaction(small, 1).vin.size();
+			} },
+			{ "GetRawTransaction/1000in", [&](){
+				sink = btc.getRawTransaction(large, 1).vin.size();
+			} },
+			{ "GetRawTransactionDecoded/small", [&](){
+				sink = btc.getRawTransactionDecoded(small).vin.size();
+			} },
+			{ "GetRawTransactionDecoded/1000in", [&](){
+				sink = btc.getRawTransactionDecoded(large).vin.size();
+			} },
+			{ "GetTransaction", [&](){
+				sink = btc.getTransaction(small).details.size();
+			} },
+			{ "GetMiningInfo", [&](){
+				sink = btc.getMiningInfo().blocks;
+			} },
+		};
+
+		std::printf("%-36s %12s %12s %12s %12s\n", "Benchmark", "ns/op", "Iterations", "allocs/op", "bytes/op");
+		std::printf("%s\n", std::string(36 + 4 * 13, '-').c_str());
+		for(size_t i = 0; i < benchmarks.size(); ++i){
+			if(benchmarks[i].name.find(filter) != std::string::npos){
+				measure(benchmarks[i], minTime);
+			}
+		}
+	}
+	catch(RaptoreumException& e){
+		std::fprintf(stderr, "Error (%d): %s\n", e.getCode(), e.getMessage().c_str());
+		return 1;
+	}
+	catch(std::exception& e){
+		std::fprintf(stderr, "Error: %s\n", e.what());
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file    main.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Standalone mock raptoreumd. Options follow the daemon's
+ * -name=value form, see usage below.
+ */
+
+#include "mockdaemon.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void onSignal(int){
+	stopRequested = 1;
+}
+
+static void usage(){
+	std::cerr << "Usage: raptoreumd_mock [options]\n"
+	          << "  -rpcport=<port>        Listen on 127.0.0.1:<port> (default: 8332, 0 for any)\n"
+	          << "  -rpcuser=<user>        Required user name (default: any)\n"
+	          << "  -rpcpassword=<pw>      Required password\n"
+	          << "  -blocks=<n>            Length of the synthetic chain (default: 200)\n"
+	          << "  -address=<address>     Receiver of the synthetic coinbases\n"
+	          << "  -fixtures=<file>       Recorded responses, served before the synthetic chain\n"
+	          << "  -latency=<us>          Delay added to every request\n"
+	          << "  -jitter=<us>           Random variation of the delay\n"
+	          << "  -errorrate=<share>     Share of calls answered with an error\n"
+	          << "  -errorcode=<code>      Code of the injected errors (default: -32603)\n"
+	          << "  -droprate=<share>      Share of requests whose connection is dropped\n";
+}
+
+int main(int argc, char * argv[]){
+	mockconfig_t config;
+	std::string fixtures;
+	config.port = 8332;
+
+	for(int i = 1; i < argc; ++i){
+		std::string arg = argv[i];
+		size_t eq = arg.find('=');
+		std::string name = arg.substr(0, eq);
+		std::string value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+
+		if(name == "-rpcport") config.port = std::atoi(value.c_str());
+		else if(name == "-rpcuser") config.user = value;
+		else if(name == "-rpcpassword") config.password = value;
+		else if(name == "-blocks") config.blocks = std::strtoul(value.c_str(), NULL, 10);
+		else if(name == "-address") config.address = value;
+		else if(name == "-fixtures") fixtures = value;
+		else if(name == "-latency") config.latency = std::strtoul(value.c_str(), NULL, 10);
+		else if(name == "-jitter") config.jitter = std::strtoul(value.c_str(), NULL, 10);
+		else if(name == "-errorrate") config.errorRate = std::atof(value.c_str());
+		else if(name == "-errorcode") config.errorCode = std::atoi(value.c_str());
+		else if(name == "-droprate") config.dropRate = std::atof(value.c_str());
+		else{
+			usage();
+			return (name == "-h" || name == "-help" || name == "--help") ? 0 : 1;
+		}
+	}
+
+	try{
+		MockDaemon daemon(config);
+		if(!fixtures.empty()){
+			daemon.loadFixtures(fixtures);
+		}
+
+		std::signal(SIGINT, onSignal);
+		std::signal(SIGTERM, onSignal);
+
+		int port = daemon.start();
+		std::cout << "raptoreumd_mock listening on 127.0.0.1:" << port
+		          << ", chain height " << daemon.getBlockCount() << std::endl;
+
+		while(!stopRequested){
+			usleep(100000);
+		}
+
+		daemon.stop();
+		std::cout << "Served " << daemon.getRequestCount() << " requests" << std::endl;
+	}
+	catch(std::exception& e){
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,930 @@
+/**
+ * @file    mockdaemon.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of a mock raptoreumd for hermetic tests
+ * and benchmarks.
+ */
+
+#include "mockdaemon.h"
+
+#include <raptoreumapi/block.h>
+#include <raptoreumapi/exception.h>
+#include <raptoreumapi/hash.h>
+#include <raptoreumapi/hex.h>
+#include <raptoreumapi/serialize.h>
+#include <raptoreumapi/transaction.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using Json::Value;
+
+using std::string;
+using std::vector;
+
+// Time of the synthetic genesis block and the spacing after it
+static const unsigned int GENESIS_TIME = 1614369600;
+static const unsigned int BLOCK_SPACING = 120;
+static const uint32_t BLOCK_BITS = 0x1e0ffff0;
+
+/* Error answered to a call, as the daemon's RPC errors */
+struct mockerror_t{
+	int code;
+	string message;
+};
+
+static void fail(int code, const string& message){
+	mockerror_t error = { code, message };
+	throw error;
+}
+
+mockconfig_t::mockconfig_t()
+: port(0),
+  latency(0),
+  jitter(0),
+  errorRate(0),
+  errorCode(-32603),
+  dropRate(0),
+  blocks(200),
+  address("RND8XfMQjb8tZ1GCKhq4fS23JX3UXDGkv5")
+{
+}
+
+static string base64(const string& in){
+	static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	string out;
+	size_t i = 0;
+
+	for(; i + 2 < in.size(); i += 3){
+		uint32_t v = ((unsigned char) in[i] << 16) | ((unsigned char) in[i + 1] << 8) | (unsigned char) in[i + 2];
+		out += table[v >> 18];
+		out += table[(v >> 12) & 0x3F];
+		out += table[(v >> 6) & 0x3F];
+		out += table[v & 0x3F];
+	}
+	if(i + 1 == in.size()){
+		uint32_t v = (unsigned char) in[i] << 16;
+		out += table[v >> 18];
+		out += table[(v >> 12) & 0x3F];
+		out += "==";
+	}else if(i + 2 == in.size()){
+		uint32_t v = ((unsigned char) in[i] << 16) | ((unsigned char) in[i + 1] << 8);
+		out += table[v >> 18];
+		out += table[(v >> 12) & 0x3F];
+		out += table[(v >> 6) & 0x3F];
+		out += '=';
+	}
+
+	return out;
+}
+
+MockDaemon::MockDaemon(const mockconfig_t& config)
+: config(config),
+  params(MainNetParams()),
+  random(std::random_device{}()),
+  listenFd(-1),
+  running(false),
+  requests(0)
+{
+	if(!config.user.empty()){
+		authorization = "Basic " + base64(config.user + ":" + config.password);
+	}
+	buildChain();
+}
+
+MockDaemon::~MockDaemon(){
+	stop();
+}
+
+/* === Synthetic chain === */
+
+void MockDaemon::buildChain(){
+	vector<unsigned char> payScript;
+	if(!AddressToScript(config.address, payScript, params)){
+		params = TestNetParams();
+		if(!AddressToScript(config.address, payScript, params)){
+			throw std::invalid_argument("Invalid address " + config.address);
+		}
+	}
+
+	if(config.blocks == 0){
+		throw std::invalid_argument("The chain needs at least one block");
+	}
+
+	unsigned char prev[32] = { 0 };
+	unsigned char hash[32];
+	vector<unsigned char> tx, block;
+
+	hashes.resize(config.blocks);
+	blockHex.resize(config.blocks);
+	blocks.resize(config.blocks);
+
+	for(unsigned int h = 0; h < config.blocks; ++h){
+		/* Coinbase with the height in its script, as BIP 34 */
+		tx.clear();
+		ByteWriter txWriter(tx);
+		txWriter.writeUInt32(1);
+		txWriter.writeCompactSize(1);
+		for(int i = 0; i < 32; ++i){
+			txWriter.writeUInt8(0);
+		}
+		txWriter.writeUInt32(0xFFFFFFFF);
+		txWriter.writeCompactSize(5);
+		txWriter.writeUInt8(4);
+		txWriter.writeUInt32(h);
+		txWriter.writeUInt32(0xFFFFFFFF);
+		txWriter.writeCompactSize(1);
+		txWriter.writeUInt64(MOCK_COINBASE_REWARD);
+		txWriter.writeBytes(&payScript[0], payScript.size());
+		txWriter.writeUInt32(0);
+
+		/* A single transaction is its own merkle root */
+		unsigned char txid[32];
+		DoubleSha256(&tx[0], tx.size(), txid);
+
+		block.clear();
+		ByteWriter blockWriter(block);
+		blockWriter.writeUInt32(0x20000000);
+		blockWriter.write(prev, 32);
+		blockWriter.write(txid, 32);
+		blockWriter.writeUInt32(GENESIS_TIME + h * BLOCK_SPACING);
+		blockWriter.writeUInt32(BLOCK_BITS);
+		blockWriter.writeUInt32(h);
+		blockWriter.writeCompactSize(1);
+		blockWriter.write(&tx[0], tx.size());
+
+		DoubleSha256(&block[0], BLOCK_HEADER_SIZE, hash);
+		std::memcpy(prev, hash, 32);
+
+		DecodeBlock(&block[0], block.size(), blocks[h], params, 1);
+		hashes[h] = blocks[h].hash;
+		blockHex[h] = HexStr(&block[0], block.size());
+		heights[hashes[h]] = h;
+		chainTxs[blocks[h].tx[0].txid] = std::make_pair((int) h, (size_t) 0);
+	}
+}
+
+int MockDaemon::getBlockCount() const{
+	return (int) hashes.size() - 1;
+}
+
+string MockDaemon::getBlockHash(int height) const{
+	if(height < 0 || height >= (int) hashes.size()){
+		throw std::out_of_range("Block height out of range");
+	}
+	return hashes[height];
+}
+
+/* Looks an output up in the chain and the mempool, stateMutex held */
+bool MockDaemon::findOutput(const string& txid, unsigned int n, output_t& out){
+	const decoderawtransaction_t * tx = NULL;
+
+	std::map<string, std::pair<int, size_t> >::const_iterator it = chainTxs.find(txid);
+	if(it != chainTxs.end()){
+		tx = &blocks[it->second.first].tx[it->second.second];
+	}else if(mempool.count(txid)){
+		tx = &mempool[txid];
+	}
+	if(tx == NULL || n >= tx->vout.size()){
+		return false;
+	}
+
+	const vout_t& vout = tx->vout[n];
+	out.address = vout.scriptPubKey.addresses.empty() ? "" : vout.scriptPubKey.addresses[0];
+	out.script = vout.scriptPubKey.hex;
+	out.satoshis = vout.valueSat;
+	return true;
+}
+
+Value MockDaemon::transactionToJson(const getrawtransaction_t& tx, int height){
+	Value ret;
+	ret["txid"] = tx.txid;
+	ret["size"] = tx.size;
+	ret["version"] = tx.version;
+	ret["type"] = tx.type;
+	ret["locktime"] = tx.locktime;
+
+	ret["vin"] = Value(Json::arrayValue);
+	for(size_t i = 0; i < tx.vin.size(); ++i){
+		Value in;
+		if(!tx.vin[i].coinbase.empty()){
+			in["coinbase"] = tx.vin[i].coinbase;
+		}else{
+			in["txid"] = tx.vin[i].txid;
+			in["vout"] = tx.vin[i].n;
+			in["scriptSig"]["asm"] = tx.vin[i].scriptSig.assm;
+			in["scriptSig"]["hex"] = tx.vin[i].scriptSig.hex;
+		}
+		in["sequence"] = tx.vin[i].sequence;
+		ret["vin"].append(in);
+	}
+
+	ret["vout"] = Value(Json::arrayValue);
+	for(size_t i = 0; i < tx.vout.size(); ++i){
+		Value out;
+		out["value"] = tx.vout[i].valueSat / 100000000.0;
+		out["valueSat"] = (Json::Int64) tx.vout[i].valueSat;
+		out["n"] = tx.vout[i].n;
+		out["scriptPubKey"]["asm"] = tx.vout[i].scriptPubKey.assm;
+		out["scriptPubKey"]["hex"] = tx.vout[i].scriptPubKey.hex;
+		out["scriptPubKey"]["type"] = tx.vout[i].scriptPubKey.type;
+		if(!tx.vout[i].scriptPubKey.addresses.empty()){
+			out["scriptPubKey"]["reqSigs"] = tx.vout[i].scriptPubKey.reqSigs;
+			for(size_t j = 0; j < tx.vout[i].scriptPubKey.addresses.size(); ++j){
+				out["scriptPubKey"]["addresses"].append(tx.vout[i].scriptPubKey.addresses[j]);
+			}
+		}
+		ret["vout"].append(out);
+	}
+
+	if(!tx.extraPayload.empty()){
+		ret["extraPayloadSize"] = (unsigned int) tx.extraPayload.size() / 2;
+		ret["extraPayload"] = tx.extraPayload;
+	}
+	ret["hex"] = tx.hex;
+
+	if(height >= 0){
+		unsigned int time = blocks[height].time;
+		ret["blockhash"] = hashes[height];
+		ret["height"] = height;
+		ret["confirmations"] = getBlockCount() - height + 1;
+		ret["time"] = time;
+		ret["blocktime"] = time;
+	}
+
+	return ret;
+}
+
+/* === Recorded responses === */
+
+void MockDaemon::loadFixtures(const string& file){
+	std::ifstream in(file.c_str());
+	Value root;
+	Json::Reader reader;
+
+	if(!in || !reader.parse(in, root) || !root.isObject()){
+		throw std::runtime_error("Invalid fixtures file " + file);
+	}
+
+	std::lock_guard<std::mutex> lock(stateMutex);
+	vector<string> methods = root.getMemberNames();
+	for(size_t i = 0; i < methods.size(); ++i){
+		const Value& entries = root[methods[i]];
+		for(Json::ArrayIndex j = 0; j < entries.size(); ++j){
+			recorded_t entry;
+			entry.anyParams = !entries[j].isMember("params");
+			entry.params = entries[j]["params"];
+			if(entries[j].isMember("error")){
+				entry.response["error"] = entries[j]["error"];
+			}else{
+				entry.response["result"] = entries[j]["result"];
+			}
+			recorded[methods[i]].push_back(entry);
+		}
+	}
+}
+
+void MockDaemon::setResponse(const string& method, const Value& result){
+	std::lock_guard<std::mutex> lock(stateMutex);
+	recorded_t entry;
+	entry.anyParams = true;
+	entry.response["result"] = result;
+	recorded[method].push_back(entry);
+}
+
+void MockDaemon::setResponse(const string& method, const Value& params, const Value& result){
+	std::lock_guard<std::mutex> lock(stateMutex);
+	recorded_t entry;
+	entry.anyParams = false;
+	entry.params = params;
+	entry.response["result"] = result;
+	recorded[method].push_back(entry);
+}
+
+void MockDaemon::setError(const string& method, int code, const string& message){
+	std::lock_guard<std::mutex> lock(stateMutex);
+	recorded_t entry;
+	entry.anyParams = true;
+	entry.response["error"]["code"] = code;
+	entry.response["error"]["message"] = message;
+	recorded[method].push_back(entry);
+}
+
+void MockDaemon::clearResponses(){
+	std::lock_guard<std::mutex> lock(stateMutex);
+	recorded.clear();
+}
+
+/* === Calls === */
+
+static Value param(const Value& args, Json::ArrayIndex i){
+	return (args.isArray() && i < args.size()) ? args[i] : Value();
+}
+
+static bool flag(const Value& value, bool fallback){
+	if(value.isNull()){
+		return fallback;
+	}
+	return value.isBool() ? value.asBool() : value.asInt() != 0;
+}
+
+/* A single address or {"addresses": [...]} */
+static std::set<string> addresses(const Value& arg){
+	std::set<string> ret;
+	if(arg.isString()){
+		ret.insert(arg.asString());
+	}else if(arg.isObject() && arg["addresses"].isArray()){
+		for(Json::ArrayIndex i = 0; i < arg["addresses"].size(); ++i){
+			ret.insert(arg["addresses"][i].asString());
+		}
+	}else{
+		fail(-5, "Invalid address");
+	}
+	return ret;
+}
+
+static string hashParam(const Value& arg){
+	unsigned char hash[32];
+	if(!arg.isString() || !ParseHash(arg.asString(), hash)){
+		fail(-8, "parameter 1 must be hexadecimal string");
+	}
+	return arg.asString();
+}
+
+Value MockDaemon::dispatch(const string& method, const Value& args){
+	std::lock_guard<std::mutex> lock(stateMutex);
+	int tip = getBlockCount();
+	Value ret;
+
+	if(method == "getblockcount"){
+		ret = tip;
+
+	}else if(method == "getbestblockhash"){
+		ret = hashes[tip];
+
+	}else if(method == "getblockhash"){
+		int height = param(args, 0).asInt();
+		if(height < 0 || height > tip){
+			fail(-8, "Block height out of range");
+		}
+		ret = hashes[height];
+
+	}else if(method == "getblock"){
+		std::map<string, int>::const_iterator it = heights.find(hashParam(param(args, 0)));
+		if(it == heights.end()){
+			fail(-5, "Block not found");
+		}
+		int height = it->second;
+		const rawblock_t& block = blocks[height];
+
+		if(!flag(param(args, 1), true)){
+			return blockHex[height];
+		}
+
+		char chainwork[65];
+		std::snprintf(chainwork, sizeof(chainwork), "%064x", (unsigned int) (height + 1) * 0x100010u);
+
+		ret["hash"] = block.hash;
+		ret["confirmations"] = tip - height + 1;
+		ret["size"] = block.size;
+		ret["height"] = height;
+		ret["version"] = block.version;
+		ret["merkleroot"] = block.merkleroot;
+		ret["tx"] = Value(Json::arrayValue);
+		for(size_t i = 0; i < block.tx.size(); ++i){
+			ret["tx"].append(block.tx[i].txid);
+		}
+		ret["time"] = block.time;
+		ret["nonce"] = block.nonce;
+		ret["bits"] = block.bits;
+		ret["difficulty"] = 0.000244140625;
+		ret["chainwork"] = chainwork;
+		if(height > 0){
+			ret["previousblockhash"] = hashes[height - 1];
+		}
+		if(height < tip){
+			ret["nextblockhash"] = hashes[height + 1];
+		}
+
+	}else if(method == "getrawtransaction"){
+		string txid = hashParam(param(args, 0));
+		bool verbose = flag(param(args, 1), false);
+		std::map<string, std::pair<int, size_t> >::const_iterator it = chainTxs.find(txid);
+
+		getrawtransaction_t tx;
+		int height = -1;
+		if(it != chainTxs.end()){
+			height = it->second.first;
+			const decoderawtransaction_t& decoded = blocks[height].tx[it->second.second];
+			static_cast<decoderawtransaction_t&>(tx) = decoded;
+			/* Synthetic blocks hold just the coinbase */
+			tx.hex = blockHex[height].substr(2 * (BLOCK_HEADER_SIZE + 1));
+		}else if(mempool.count(txid)){
+			tx = mempool[txid];
+		}else{
+			fail(-5, "No such mempool or blockchain transaction. Use gettransaction for wallet transactions.");
+		}
+		ret = verbose ? transactionToJson(tx, height) : Value(tx.hex);
+
+	}else if(method == "sendrawtransaction"){
+		getrawtransaction_t tx;
+		try{
+			DecodeRawTransaction(param(args, 0).asString(), tx, params);
+		}
+		catch(RaptoreumException& e){
+			fail(-22, "TX decode failed");
+		}
+		if(chainTxs.count(tx.txid)){
+			fail(-27, "transaction already in block chain");
+		}
+		if(mempool.count(tx.txid)){
+			fail(-26, "txn-already-in-mempool");
+		}
+
+		/* Inputs and signatures are not checked, double spends are */
+		for(std::map<string, getrawtransaction_t>::const_iterator it = mempool.begin(); it != mempool.end(); ++it){
+			for(size_t i = 0; i < it->second.vin.size(); ++i){
+				for(size_t j = 0; j < tx.vin.size(); ++j){
+					if(!tx.vin[j].txid.empty() && tx.vin[j].txid == it->second.vin[i].txid
+					   && tx.vin[j].n == it->second.vin[i].n){
+						fail(-26, "txn-mempool-conflict");
+					}
+				}
+			}
+		}
+
+		mempool[tx.txid] = tx;
+		mempoolTime[tx.txid] = GENESIS_TIME + tip * BLOCK_SPACING + (unsigned int) mempool.size();
+		ret = tx.txid;
+
+	}else if(method == "getrawmempool"){
+		ret = Value(Json::arrayValue);
+		for(std::map<string, getrawtransaction_t>::const_iterator it = mempool.begin(); it != mempool.end(); ++it){
+			ret.append(it->first);
+		}
+
+	}else if(method == "getmempoolentry"){
+		string txid = hashParam(param(args, 0));
+		if(!mempool.count(txid)){
+			fail(-5, "Transaction not in mempool");
+		}
+		const getrawtransaction_t& tx = mempool[txid];
+
+		/* The fee is only known when all inputs are */
+		int64_t fee = 0;
+		output_t prevout;
+		bool known = true;
+		for(size_t i = 0; i < tx.vin.size() && known; ++i){
+			known = findOutput(tx.vin[i].txid, tx.vin[i].n, prevout);
+			fee += prevout.satoshis;
+		}
+		for(size_t i = 0; i < tx.vout.size(); ++i){
+			fee -= tx.vout[i].valueSat;
+		}
+
+		ret["size"] = tx.size;
+		ret["fee"] = (known && fee > 0) ? fee / 100000000.0 : 0.0;
+		ret["time"] = mempoolTime[txid];
+		ret["height"] = tip;
+
+	}else if(method == "getmininginfo"){
+		ret["blocks"] = tip;
+		ret["currentblocksize"] = 0;
+		ret["currentblocktx"] = 0;
+		ret["difficulty"] = 0.000244140625;
+		ret["errors"] = "";
+		ret["networkhashps"] = 0.0;
+		ret["pooledtx"] = (unsigned int) mempool.size();
+		ret["chain"] = (params.pubkeyPrefix == MainNetParams().pubkeyPrefix) ? "main" : "test";
+
+	}else if(method == "getaddressbalance" || method == "getaddresstxids"
+	         || method == "getaddressdeltas" || method == "getaddressutxos"){
+		Value query = param(args, 0);
+		std::set<string> wanted = addresses(query);
+		int start = query.isObject() ? query["start"].asInt() : 0;
+		int end = query.isObject() ? query["end"].asInt() : 0;
+		int64_t balance = 0, received = 0;
+		std::set<string> seen;
+		ret = Value(Json::arrayValue);
+
+		/* Only coinbases are confirmed, so nothing in the chain is spent */
+		for(int h = 0; h <= tip; ++h){
+			if((start != 0 || end != 0) && (h < start || h > end)){
+				continue;
+			}
+			for(size_t t = 0; t < blocks[h].tx.size(); ++t){
+				const decoderawtransaction_t& tx = blocks[h].tx[t];
+				for(size_t n = 0; n < tx.vout.size(); ++n){
+					const scriptPubKey_t& script = tx.vout[n].scriptPubKey;
+					if(script.addresses.empty() || !wanted.count(script.addresses[0])){
+						continue;
+					}
+					balance += tx.vout[n].valueSat;
+					received += tx.vout[n].valueSat;
+
+					Value entry;
+					entry["address"] = script.addresses[0];
+					entry["txid"] = tx.txid;
+					entry["satoshis"] = (Json::Int64) tx.vout[n].valueSat;
+					entry["height"] = h;
+					if(method == "getaddressdeltas"){
+						entry["index"] = (unsigned int) n;
+						entry["blockindex"] = (unsigned int) t;
+						ret.append(entry);
+					}else if(method == "getaddressutxos"){
+						entry["outputIndex"] = (unsigned int) n;
+						entry["script"] = script.hex;
+						ret.append(entry);
+					}else if(method == "getaddresstxids" && seen.insert(tx.txid).second){
+						ret.append(tx.txid);
+					}
+				}
+			}
+		}
+
+		if(method == "getaddressbalance"){
+			ret = Value();
+			ret["balance"] = (Json::Int64) balance;
+			ret["received"] = (Json::Int64) received;
+		}
+
+	}else if(method == "getaddressmempool"){
+		std::set<string> wanted = addresses(param(args, 0));
+		output_t prevout;
+		ret = Value(Json::arrayValue);
+
+		for(std::map<string, getrawtransaction_t>::const_iterator it = mempool.begin(); it != mempool.end(); ++it){
+			const getrawtransaction_t& tx = it->second;
+			for(size_t i = 0; i < tx.vin.size(); ++i){
+				if(!findOutput(tx.vin[i].txid, tx.vin[i].n, prevout) || !wanted.count(prevout.address)){
+					continue;
+				}
+				Value entry;
+				entry["address"] = prevout.address;
+				entry["txid"] = tx.txid;
+				entry["index"] = (unsigned int) i;
+				entry["satoshis"] = (Json::Int64) -prevout.satoshis;
+				entry["timestamp"] = mempoolTime[tx.txid];
+				entry["prevtxid"] = tx.vin[i].txid;
+				entry["prevout"] = tx.vin[i].n;
+				ret.append(entry);
+			}
+			for(size_t n = 0; n < tx.vout.size(); ++n){
+				const scriptPubKey_t& script = tx.vout[n].scriptPubKey;
+				if(script.addresses.empty() || !wanted.count(script.addresses[0])){
+					continue;
+				}
+				Value entry;
+				entry["address"] = script.addresses[0];
+				entry["txid"] = tx.txid;
+				entry["index"] = (unsigned int) n;
+				entry["satoshis"] = (Json::Int64) tx.vout[n].valueSat;
+				entry["timestamp"] = mempoolTime[tx.txid];
+				ret.append(entry);
+			}
+		}
+
+	}else if(method == "getspentinfo"){
+		Value query = param(args, 0);
+		if(!query.isObject()){
+			fail(-8, "Invalid parameter");
+		}
+		string txid = query["txid"].asString();
+		unsigned int index = query["index"].asUInt();
+
+		for(std::map<string, getrawtransaction_t>::const_iterator it = mempool.begin(); it != mempool.end(); ++it){
+			for(size_t i = 0; i < it->second.vin.size(); ++i){
+				if(it->second.vin[i].txid == txid && it->second.vin[i].n == index){
+					ret["txid"] = it->first;
+					ret["index"] = (unsigned int) i;
+					ret["height"] = -1;
+					return ret;
+				}
+			}
+		}
+		fail(-5, "Unable to get spent info");
+
+	}else{
+		fail(-32601, "Method not found");
+	}
+
+	return ret;
+}
+
+Value MockDaemon::call(const Value& request){
+	Value response;
+	response["id"] = request["id"];
+	response["result"] = Value();
+	response["error"] = Value();
+
+	string method = request["method"].asString();
+	const Value& args = request["params"];
+
+	if(config.errorRate > 0 && uniform() < config.errorRate){
+		response["error"]["code"] = config.errorCode;
+		response["error"]["message"] = "Injected error";
+		return response;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		std::map<string, vector<recorded_t> >::const_iterator it = recorded.find(method);
+		if(it != recorded.end()){
+			for(size_t i = 0; i < it->second.size(); ++i){
+				if(it->second[i].anyParams || it->second[i].params == args){
+					const Value& recordedResponse = it->second[i].response;
+					if(recordedResponse.isMember("error")){
+						response["error"] = recordedResponse["error"];
+					}else{
+						response["result"] = recordedResponse["result"];
+					}
+					return response;
+				}
+			}
+		}
+	}
+
+	try{
+		response["result"] = dispatch(method, args);
+	}
+	catch(mockerror_t& e){
+		response["error"]["code"] = e.code;
+		response["error"]["message"] = e.message;
+	}
+	catch(std::exception& e){
+		response["error"]["code"] = -1;
+		response["error"]["message"] = e.what();
+	}
+
+	return response;
+}
+
+/* Single calls map their error to the HTTP status like the daemon does */
+string MockDaemon::handle(const string& body, int& status){
+	Json::Reader reader;
+	Json::FastWriter writer;
+	Value request, response;
+
+	if(!reader.parse(body, request) || !(request.isObject() || request.isArray())){
+		status = 500;
+		response["result"] = Value();
+		response["error"]["code"] = -32700;
+		response["error"]["message"] = "Parse error";
+		response["id"] = Value();
+		return writer.write(response);
+	}
+
+	status = 200;
+	if(request.isArray()){
+		response = Value(Json::arrayValue);
+		for(Json::ArrayIndex i = 0; i < request.size(); ++i){
+			response.append(call(request[i]));
+		}
+	}else{
+		response = call(request);
+		if(!response["error"].isNull()){
+			status = (response["error"]["code"].asInt() == -32601) ? 404 : 500;
+		}
+	}
+
+	return writer.write(response);
+}
+
+/* === Server === */
+
+double MockDaemon::uniform(){
+	std::lock_guard<std::mutex> lock(randomMutex);
+	return std::uniform_real_distribution<double>(0.0, 1.0)(random);
+}
+
+int MockDaemon::start(){
+	if(running){
+		return config.port;
+	}
+
+	listenFd = socket(AF_INET, SOCK_STREAM, 0);
+	if(listenFd < 0){
+		throw std::runtime_error(string("socket: ") + std::strerror(errno));
+	}
+
+	int one = 1;
+	setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+	sockaddr_in addr;
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = htons((uint16_t) config.port);
+
+	socklen_t addrLen = sizeof(addr);
+	if(bind(listenFd, (sockaddr*) &addr, sizeof(addr)) != 0 || listen(listenFd, 128) != 0
+	   || getsockname(listenFd, (sockaddr*) &addr, &addrLen) != 0){
+		string error = std::strerror(errno);
+		close(listenFd);
+		listenFd = -1;
+		throw std::runtime_error("Cannot listen on port " + std::to_string(config.port) + ": " + error);
+	}
+
+	config.port = ntohs(addr.sin_port);
+	running = true;
+	acceptThread = std::thread(&MockDaemon::acceptLoop, this);
+
+	return config.port;
+}
+
+void MockDaemon::stop(){
+	if(!running){
+		return;
+	}
+
+	running = false;
+	acceptThread.join();
+	close(listenFd);
+	listenFd = -1;
+	reapConnections(true);
+}
+
+int MockDaemon::getPort() const{
+	return config.port;
+}
+
+unsigned long MockDaemon::getRequestCount() const{
+	return requests;
+}
+
+void MockDaemon::acceptLoop(){
+	pollfd pfd;
+	pfd.fd = listenFd;
+	pfd.events = POLLIN;
+
+	while(running){
+		reapConnections(false);
+		if(poll(&pfd, 1, 100) <= 0){
+			continue;
+		}
+
+		int fd = accept(listenFd, NULL, NULL);
+		if(fd < 0){
+			continue;
+		}
+		int one = 1;
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+		std::lock_guard<std::mutex> lock(connectionsMutex);
+		connections.push_back(std::unique_ptr<connection_t>(new connection_t()));
+		connection_t * connection = connections.back().get();
+		connection->fd = fd;
+		connection->done = false;
+		connection->thread = std::thread(&MockDaemon::serve, this, connection);
+	}
+}
+
+/* Joins finished connection threads, or all of them after closing their sockets */
+void MockDaemon::reapConnections(bool all){
+	std::lock_guard<std::mutex> lock(connectionsMutex);
+
+	for(std::list<std::unique_ptr<connection_t> >::iterator it = connections.begin(); it != connections.end();){
+		connection_t * connection = it->get();
+		if(!all && !connection->done){
+			++it;
+			continue;
+		}
+		if(all){
+			shutdown(connection->fd, SHUT_RDWR);
+		}
+		connection->thread.join();
+		close(connection->fd);
+		it = connections.erase(it);
+	}
+}
+
+static bool sendAll(int fd, const string& data){
+	size_t sent = 0;
+	while(sent < data.size()){
+		ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+		if(n <= 0){
+			return false;
+		}
+		sent += n;
+	}
+	return true;
+}
+
+static string lower(string s){
+	std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+	return s;
+}
+
+void MockDaemon::serve(connection_t * connection){
+	int fd = connection->fd;
+	string buffer;
+	char chunk[65536];
+
+	while(running){
+		/* Headers */
+		size_t headerEnd;
+		bool open = true;
+		while((headerEnd = buffer.find("\r\n\r\n")) == string::npos && open){
+			ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+			open = n > 0;
+			if(open){
+				buffer.append(chunk, n);
+			}
+		}
+		if(!open){
+			break;
+		}
+
+		size_t contentLength = 0;
+		bool keepAlive = true, expectContinue = false;
+		string auth;
+		size_t lineStart = buffer.find("\r\n") + 2;
+		while(lineStart < headerEnd){
+			size_t lineEnd = buffer.find("\r\n", lineStart);
+			size_t colon = buffer.find(':', lineStart);
+			if(colon < lineEnd){
+				string name = lower(buffer.substr(lineStart, colon - lineStart));
+				size_t valueStart = buffer.find_first_not_of(' ', colon + 1);
+				string value = buffer.substr(valueStart, lineEnd - valueStart);
+				if(name == "content-length"){
+					contentLength = std::strtoul(value.c_str(), NULL, 10);
+				}else if(name == "authorization"){
+					auth = value;
+				}else if(name == "connection"){
+					keepAlive = lower(value) != "close";
+				}else if(name == "expect"){
+					expectContinue = lower(value) == "100-continue";
+				}
+			}
+			lineStart = lineEnd + 2;
+		}
+
+		/* Body */
+		size_t bodyStart = headerEnd + 4;
+		if(expectContinue && buffer.size() < bodyStart + contentLength){
+			sendAll(fd, "HTTP/1.1 100 Continue\r\n\r\n");
+		}
+		while(buffer.size() < bodyStart + contentLength && open){
+			ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+			open = n > 0;
+			if(open){
+				buffer.append(chunk, n);
+			}
+		}
+		if(!open){
+			break;
+		}
+		string body = buffer.substr(bodyStart, contentLength);
+		buffer.erase(0, bodyStart + contentLength);
+		++requests;
+
+		/* Faults */
+		if(config.dropRate > 0 && uniform() < config.dropRate){
+			break;
+		}
+		if(config.latency > 0 || config.jitter > 0){
+			double delay = config.latency + (2 * uniform() - 1) * config.jitter;
+			if(delay > 0){
+				std::this_thread::sleep_for(std::chrono::microseconds((long) delay));
+			}
+		}
+
+		int status = 401;
+		string response;
+		if(authorization.empty() || auth == authorization){
+			response = handle(body, status);
+		}
+
+		const char * reason = (status == 200) ? "OK" : (status == 401) ? "Unauthorized"
+		                    : (status == 404) ? "Not Found" : "Internal Server Error";
+		char header[256];
+		std::snprintf(header, sizeof(header),
+		              "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %lu\r\n"
+		              "Connection: %s\r\n\r\n",
+		              status, reason, (unsigned long) response.size(), keepAlive ? "keep-alive" : "close");
+
+		if(!sendAll(fd, header + response) || !keepAlive){
+			break;
+		}
+	}
+
+	/* The socket is closed once the thread is joined, signal the end now */
+	shutdown(fd, SHUT_RDWR);
+	connection->done = true;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file    mockdaemon.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of a mock raptoreumd that answers the JSON-RPC
+ * calls wrapped by the library from a synthetic chain or from
+ * recorded responses, with configurable latency and faults.
+ */
+
+#ifndef RAPTOREUM_API_MOCKDAEMON_H
+#define RAPTOREUM_API_MOCKDAEMON_H
+
+#include <raptoreumapi/types.h>
+#include <raptoreumapi/script.h>
+
+#include <jsoncpp/json/json.h>
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Value of every synthetic coinbase output, in satoshis
+static const int64_t MOCK_COINBASE_REWARD = 5000 * 100000000LL;
+
+struct mockconfig_t{
+	std::string user;               // empty to accept any credentials
+	std::string password;
+	int port;                       // 0 picks a free one
+	unsigned int latency;           // microseconds added to every request
+	unsigned int jitter;            // up to this many microseconds more or less
+	double errorRate;               // share of calls answered with errorCode
+	int errorCode;
+	double dropRate;                // share of requests whose connection is closed unanswered
+	unsigned int blocks;            // length of the synthetic chain
+	std::string address;            // receives the synthetic coinbase outputs
+
+	mockconfig_t();
+};
+
+/*
+ * Speaks HTTP/1.1 with keep-alive on 127.0.0.1 like the daemon: single
+ * calls that fail get status 500 (404 for unknown methods), batches 200,
+ * bad credentials 401. Each connection is served by its own thread.
+ *
+ * Recorded responses, from setResponse or a fixtures file, take precedence
+ * over the synthetic chain. The file maps method names to lists of
+ *
+ *   { "params": [...], "result": ... }   or   { "error": {"code": .., "message": ..} }
+ *
+ * where entries without "params" match any call of the method.
+ */
+class MockDaemon
+{
+
+private:
+    struct recorded_t{
+        bool anyParams;
+        Json::Value params;
+        Json::Value response;       // {"result": ...} or {"error": ...}
+    };
+
+    struct output_t{
+        std::string address;
+        std::string script;
+        int64_t satoshis;
+    };
+
+    struct connection_t{
+        int fd;
+        std::thread thread;
+        std::atomic<bool> done;
+    };
+
+    mockconfig_t config;
+    chainparams_t params;
+    std::string authorization;
+
+    /* Synthetic chain, read only once built */
+    std::vector<std::string> hashes;
+    std::vector<std::string> blockHex;
+    std::vector<rawblock_t> blocks;
+    std::map<std::string, int> heights;
+    std::map<std::string, std::pair<int, size_t> > chainTxs;
+
+    /* Mempool and recorded responses, changed by calls */
+    std::mutex stateMutex;
+    std::map<std::string, getrawtransaction_t> mempool;
+    std::map<std::string, unsigned int> mempoolTime;
+    std::map<std::string, std::vector<recorded_t> > recorded;
+
+    std::mutex randomMutex;
+    std::mt19937_64 random;
+
+    int listenFd;
+    std::atomic<bool> running;
+    std::atomic<unsigned long> requests;
+    std::thread acceptThread;
+    std::mutex connectionsMutex;
+    std::list<std::unique_ptr<connection_t> > connections;
+
+    void buildChain();
+    bool findOutput(const std::string& txid, unsigned int n, output_t& out);
+    Json::Value transactionToJson(const getrawtransaction_t& tx, int height);
+
+    double uniform();
+    void acceptLoop();
+    void serve(connection_t * connection);
+    void reapConnections(bool all);
+    std::string handle(const std::string& body, int& status);
+    Json::Value call(const Json::Value& request);
+    Json::Value dispatch(const std::string& method, const Json::Value& args);
+
+public:
+    explicit MockDaemon(const mockconfig_t& config = mockconfig_t());
+    ~MockDaemon();
+
+    // Binds and starts serving, returns the port
+    int start();
+    void stop();
+
+    int getPort() const;
+    unsigned long getRequestCount() const;
+
+    /* === Synthetic chain === */
+    int getBlockCount() const;
+    std::string getBlockHash(int height) const;
+
+    /* === Recorded responses === */
+    void loadFixtures(const std::string& file);
+    void setResponse(const std::string& method, const Json::Value& result);
+    void setResponse(const std::string& method, const Json::Value& params, const Json::Value& result);
+    void setError(const std::string& method, int code, const std::string& message);
+    void clearResponses();
+};
+
+
+#endif
@@ -0,0 +1,257 @@
+/**
+ * @file    block.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Local decoding of serialized Raptoreum blocks.
+ */
+
+#include "block.h"
+#include "transaction.h"
+#include "serialize.h"
+#include "hash.h"
+#include "hex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+using jsonrpc::Errors;
+
+using std::string;
+using std::vector;
+
+/* Transactions handed to a worker at a time, and the least a thread is started for */
+static const size_t DECODE_CHUNK = 32;
+
+/* Merkle levels with fewer pairs than this are hashed on the calling thread */
+static const size_t MERKLE_PARALLEL_PAIRS = 2048;
+
+
+void DecodeBlockHeader(const unsigned char * data, size_t len, blockheader_t& ret){
+	ByteReader reader(data, len);
+
+	ret.version = (int) reader.readUInt32();
+	HexStr(reader.read(32), 32, ret.previousblockhash, true);
+	HexStr(reader.read(32), 32, ret.merkleroot, true);
+	ret.time = reader.readUInt32();
+
+	char bits[9];
+	std::snprintf(bits, sizeof(bits), "%08x", reader.readUInt32());
+	ret.bits = bits;
+
+	ret.nonce = reader.readUInt32();
+
+	unsigned char hash[32];
+	DoubleSha256(data, BLOCK_HEADER_SIZE, hash);
+	HexStr(hash, sizeof(hash), ret.hash, true);
+}
+
+void DecodeBlock(const unsigned char * data, size_t len, rawblock_t& ret,
+                 const chainparams_t& params, unsigned int threads){
+	DecodeBlockHeader(data, len, ret);
+
+	ByteReader reader(data, len);
+	reader.read(BLOCK_HEADER_SIZE);
+	uint64_t count = reader.readCompactSize();
+	if(count > reader.remaining()){
+		throw RaptoreumException(Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid block: transaction count exceeds data");
+	}
+
+	/* Finding the boundaries only reads lengths; the decoding itself
+	 * (scripts, addresses, txids) is what gets spread over threads */
+	vector<size_t> offsets(count + 1);
+	offsets[0] = reader.position() - data;
+	for(size_t i = 0; i < count; ++i){
+		offsets[i + 1] = offsets[i] + TransactionSize(data + offsets[i], len - offsets[i]);
+	}
+	if(offsets[count] != len){
+		throw RaptoreumException(Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid block: trailing data");
+	}
+
+	ret.size = (int) len;
+	ret.tx.resize(count);
+
+	size_t chunks = (count + DECODE_CHUNK - 1) / DECODE_CHUNK;
+	if(threads == 0){
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	threads = (unsigned int) std::min<size_t>(threads, chunks);
+
+	/* Transactions are decoded in chunks, each chunk's txids hashed as one batch */
+	auto decodeChunk = [&](size_t c){
+		size_t first = c * DECODE_CHUNK;
+		size_t last = std::min<size_t>(count, first + DECODE_CHUNK);
+		const unsigned char * messages[DECODE_CHUNK] = { NULL };
+		size_t lens[DECODE_CHUNK] = { 0 };
+		unsigned char hashes[32 * DECODE_CHUNK];
+
+		for(size_t i = first; i < last; ++i){
+			messages[i - first] = data + offsets[i];
+			lens[i - first] = offsets[i + 1] - offsets[i];
+			DecodeTransaction(messages[i - first], lens[i - first], ret.tx[i], params, false);
+		}
+
+		DoubleSha256Batch(last - first, messages, lens, hashes);
+		for(size_t i = first; i < last; ++i){
+			HexStr(hashes + 32 * (i - first), 32, ret.tx[i].txid, true);
+		}
+	};
+
+	if(threads <= 1){
+		for(size_t c = 0; c < chunks; ++c){
+			decodeChunk(c);
+		}
+		return;
+	}
+
+	std::atomic<size_t> next(0);
+	std::exception_ptr error;
+	std::mutex errorMutex;
+	vector<std::thread> workers;
+
+	for(unsigned int t = 0; t < threads; ++t){
+		workers.push_back(std::thread([&](){
+			for(size_t c = next++; c < chunks; c = next++){
+				try{
+					decodeChunk(c);
+				}
+				catch(...){
+					std::lock_guard<std::mutex> lock(errorMutex);
+					if(!error){
+						error = std::current_exception();
+					}
+					next = chunks;
+				}
+			}
+		}));
+	}
+
+	for(size_t t = 0; t < workers.size(); ++t){
+		workers[t].join();
+	}
+
+	if(error){
+		std::rethrow_exception(error);
+	}
+}
+
+void DecodeRawBlock(const string& hex, rawblock_t& ret, const chainparams_t& params, unsigned int threads){
+	vector<unsigned char> data;
+	if(!HexToBytes(hex, data) || data.empty()){
+		throw RaptoreumException(Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid block: not a hex string");
+	}
+	DecodeBlock(&data[0], data.size(), ret, params, threads);
+}
+
+/* === Merkle tree === */
+
+/* Hashes pairs [first, last) of level into next */
+static void hashPairs(const unsigned char * level, size_t first, size_t last, unsigned char * next){
+	const size_t batch = 64;
+	const unsigned char * messages[batch];
+	size_t lens[batch];
+
+	for(size_t i = first; i < last; i += batch){
+		size_t n = std::min(batch, last - i);
+		for(size_t j = 0; j < n; ++j){
+			messages[j] = level + 64 * (i + j);
+			lens[j] = 64;
+		}
+		DoubleSha256Batch(n, messages, lens, next + 32 * i);
+	}
+}
+
+void ComputeMerkleRoot(const unsigned char * hashes, size_t count, unsigned char root[32],
+                       bool * mutated, unsigned int threads){
+	if(mutated != NULL){
+		*mutated = false;
+	}
+	if(count == 0){
+		std::memset(root, 0, 32);
+		return;
+	}
+	if(threads == 0){
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	/* An odd last hash of a level is paired with itself */
+	vector<unsigned char> level(hashes, hashes + 32 * count);
+	vector<unsigned char> next;
+
+	while(count > 1){
+		if(mutated != NULL){
+			for(size_t i = 0; i + 1 < count; i += 2){
+				if(std::memcmp(&level[32 * i], &level[32 * (i + 1)], 32) == 0){
+					*mutated = true;
+				}
+			}
+		}
+		if(count % 2 != 0){
+			level.insert(level.end(), level.end() - 32, level.end());
+			++count;
+		}
+
+		size_t pairs = count / 2;
+		next.resize(32 * pairs);
+
+		unsigned int workers = (unsigned int) std::min<size_t>(threads, pairs / MERKLE_PARALLEL_PAIRS);
+		if(workers <= 1){
+			hashPairs(&level[0], 0, pairs, &next[0]);
+		}else{
+			vector<std::thread> pool;
+			size_t share = (pairs + workers - 1) / workers;
+			for(unsigned int t = 0; t < workers; ++t){
+				size_t first = t * share;
+				size_t last = std::min(pairs, first + share);
+				pool.push_back(std::thread(hashPairs, &level[0], first, last, &next[0]));
+			}
+			for(size_t t = 0; t < pool.size(); ++t){
+				pool[t].join();
+			}
+		}
+
+		level.swap(next);
+		count = pairs;
+	}
+
+	std::memcpy(root, &level[0], 32);
+}
+
+static bool checkMerkleRoot(const vector<unsigned char>& txids, size_t count, const string& merkleroot,
+                            unsigned int threads){
+	unsigned char expected[32], root[32];
+	bool mutated;
+
+	if(count == 0 || !ParseHash(merkleroot, expected)){
+		return false;
+	}
+	ComputeMerkleRoot(&txids[0], count, root, &mutated, threads);
+
+	return !mutated && std::memcmp(root, expected, 32) == 0;
+}
+
+bool CheckMerkleRoot(const rawblock_t& block, unsigned int threads){
+	vector<unsigned char> txids(32 * block.tx.size());
+	for(size_t i = 0; i < block.tx.size(); ++i){
+		if(!ParseHash(block.tx[i].txid, &txids[32 * i])){
+			return false;
+		}
+	}
+	return checkMerkleRoot(txids, block.tx.size(), block.merkleroot, threads);
+}
+
+bool CheckMerkleRoot(const blockinfo_t& block, unsigned int threads){
+	vector<unsigned char> txids(32 * block.tx.size());
+	for(size_t i = 0; i < block.tx.size(); ++i){
+		if(!ParseHash(block.tx[i], &txids[32 * i])){
+			return false;
+		}
+	}
+	return checkMerkleRoot(txids, block.tx.size(), block.merkleroot, threads);
+}
@@ -0,0 +1,47 @@
+/**
+ * @file    block.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Local decoding of serialized Raptoreum blocks, so a whole
+ * block can be indexed from a single getblock call.
+ */
+
+#ifndef RAPTOREUM_API_BLOCK_H
+#define RAPTOREUM_API_BLOCK_H
+
+#include "types.h"
+#include "script.h"
+
+// Size of the serialized block header
+static const size_t BLOCK_HEADER_SIZE = 80;
+
+// Decodes the 80 byte header at the start of data. The hash is the
+// double SHA-256 of the header.
+void DecodeBlockHeader(const unsigned char * data, size_t len, blockheader_t& ret);
+
+// Decodes header and transactions. Blocks with many transactions are
+// decoded on up to threads threads, 0 picks the number of cores.
+// Throws a RaptoreumException on malformed data.
+void DecodeBlock(const unsigned char * data, size_t len, rawblock_t& ret,
+                 const chainparams_t& params = MainNetParams(), unsigned int threads = 0);
+
+// Same for a hex encoded block
+void DecodeRawBlock(const std::string& hex, rawblock_t& ret,
+                    const chainparams_t& params = MainNetParams(), unsigned int threads = 0);
+
+// Merkle root of count txids given in internal byte order, 32 bytes each.
+// mutated, if given, is set when a level has two equal adjacent hashes
+// (CVE-2012-2459). Large levels are hashed on up to threads threads.
+void ComputeMerkleRoot(const unsigned char * hashes, size_t count, unsigned char root[32],
+                       bool * mutated = NULL, unsigned int threads = 0);
+
+// Recomputes the merkle root from the txids of the block and compares it
+// with the one in the header. False on a mismatch, a mutated tree or a
+// txid that is not a hash.
+bool CheckMerkleRoot(const rawblock_t& block, unsigned int threads = 0);
+bool CheckMerkleRoot(const blockinfo_t& block, unsigned int threads = 0);
+
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file    chainfollower.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of a chain tip follower that detects
+ * reorganizations and reports them as ordered block
+ * disconnect and connect events.
+ */
+
+#include "chainfollower.h"
+
+#include <utility>
+
+using std::string;
+using std::vector;
+
+
+ChainFollower::ChainFollower(RaptoreumAPI& rpc, ChainListener& listener, unsigned int depth)
+: rpc(rpc),
+  listener(listener),
+  depth(depth > 0 ? depth : 1)
+{
+}
+
+void ChainFollower::start(const string& blockhash){
+	chain.clear();
+	chain.push_back(rpc.getBlock(blockhash));
+}
+
+bool ChainFollower::empty() const{
+	return chain.empty();
+}
+
+const blockinfo_t& ChainFollower::tip() const{
+	return chain.back();
+}
+
+bool ChainFollower::contains(const string& blockhash) const{
+	/* Lookups almost always hit near the tip */
+	for(std::deque<blockinfo_t>::const_reverse_iterator it = chain.rbegin(); it != chain.rend(); it++){
+		if((*it).hash == blockhash){
+			return true;
+		}
+	}
+	return false;
+}
+
+void ChainFollower::connect(blockinfo_t& block){
+	chain.push_back(std::move(block));
+	listener.blockConnected(chain.back());
+
+	if(chain.size() > depth){
+		chain.pop_front();
+	}
+}
+
+bool ChainFollower::poll(){
+	string best = rpc.getBestBlockHash();
+
+	if(!chain.empty() && chain.back().hash == best){
+		return false;
+	}
+
+	blockinfo_t block = rpc.getBlock(best);
+
+	if(chain.empty()){
+		connect(block);
+		return true;
+	}
+
+	/* Far behind: catch up in steps of depth blocks fetched by height,
+	   so walking back from a step never needs more than the window */
+	while(block.height > chain.back().height + (int) depth){
+		blockinfo_t step = rpc.getBlock(rpc.getBlockHash(chain.back().height + depth));
+		advance(step);
+	}
+
+	advance(block);
+	return true;
+}
+
+void ChainFollower::advance(blockinfo_t& block){
+	/* The best block moved back to one already followed: the blocks
+	   above it left the chain, with nothing new to connect */
+	if(contains(block.hash)){
+		while(chain.back().hash != block.hash){
+			listener.blockDisconnected(chain.back());
+			chain.pop_back();
+		}
+		return;
+	}
+
+	/* Walk back from the new tip until it links into the window */
+	vector<blockinfo_t> branch;
+	string fork = block.previousblockhash;
+	branch.push_back(std::move(block));
+
+	while(!contains(fork)){
+		blockinfo_t parent = rpc.getBlock(fork);
+		if(parent.height <= chain.front().height){
+			throw RaptoreumException(RPC_REORG_TOO_DEEP, "Reorganization deeper than the followed window");
+		}
+		fork = parent.previousblockhash;
+		branch.push_back(std::move(parent));
+	}
+
+	/* Blocks above the fork point left the chain */
+	while(chain.back().hash != fork){
+		listener.blockDisconnected(chain.back());
+		chain.pop_back();
+	}
+
+	for(vector<blockinfo_t>::reverse_iterator it = branch.rbegin(); it != branch.rend(); it++){
+		connect(*it);
+	}
+}
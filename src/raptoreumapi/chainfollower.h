@@ -0,0 +1,65 @@
+/**
+ * @file    chainfollower.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of a chain tip follower that detects
+ * reorganizations and reports them as ordered block
+ * disconnect and connect events.
+ */
+
+#ifndef RAPTOREUM_API_CHAINFOLLOWER_H
+#define RAPTOREUM_API_CHAINFOLLOWER_H
+
+#include "raptoreumapi.h"
+
+#include <deque>
+
+/* Receives the tip changes seen by a ChainFollower */
+class ChainListener
+{
+
+public:
+    virtual ~ChainListener() { }
+
+    // Called in height order for blocks joining the followed chain
+    virtual void blockConnected(const blockinfo_t& block) { }
+    // Called from the tip downwards for blocks leaving it in a reorg
+    virtual void blockDisconnected(const blockinfo_t& block) { }
+};
+
+class ChainFollower
+{
+
+private:
+    RaptoreumAPI& rpc;
+    ChainListener& listener;
+    unsigned int depth;
+
+    // Most recent blocks of the followed chain, tip last
+    std::deque<blockinfo_t> chain;
+
+    void connect(blockinfo_t& block);
+    void advance(blockinfo_t& block);
+    bool contains(const std::string& blockhash) const;
+
+public:
+    /* depth: number of recent blocks kept, i.e. the deepest reorg handled */
+    ChainFollower(RaptoreumAPI& rpc, ChainListener& listener, unsigned int depth = 100);
+
+    // Resumes after a known block instead of the current tip, no event is emitted for it
+    void start(const std::string& blockhash);
+
+    // Compares the daemon's best block against the followed tip and emits
+    // the events needed to catch up. Returns false if nothing changed.
+    // Throws a RaptoreumException with RPC_REORG_TOO_DEEP when the fork
+    // point lies below the window.
+    bool poll();
+
+    bool empty() const;
+    const blockinfo_t& tip() const;
+};
+
+
+#endif
@@ -0,0 +1,122 @@
+/**
+ * @file    chainscanner.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of a block range scanner that keeps several
+ * getblockhash/getblock requests in flight and delivers
+ * the decoded blocks in height order.
+ */
+
+#include "chainscanner.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+using std::map;
+using std::string;
+using std::vector;
+
+
+ChainScanner::ChainScanner(RaptoreumAPI& rpc, unsigned int connections, unsigned int window)
+: rpc(rpc),
+  connections(std::max(connections, 1u)),
+  window(std::max(window, std::max(connections, 1u)))
+{
+}
+
+void ChainScanner::scan(int from, int to, const std::function<void(const blockinfo_t&)>& consumer){
+	if(to < from){
+		return;
+	}
+
+	/* Shared between consumer and workers, guarded by lock */
+	std::mutex lock;
+	std::condition_variable changed;
+	map<int, blockinfo_t> ready;
+	int next = from;
+	int deliver = from;
+	bool stop = false;
+	std::exception_ptr error;
+
+	unsigned int count = std::min<unsigned int>(connections, to - from + 1);
+	vector<std::thread> workers;
+
+	for(unsigned int t = 0; t < count; ++t){
+		workers.push_back(std::thread([&](){
+			try{
+				RaptoreumAPI api(rpc);
+				std::unique_lock<std::mutex> guard(lock);
+
+				while(true){
+					/* Do not run more than window blocks ahead of the consumer */
+					changed.wait(guard, [&](){
+						return stop || next > to || next < deliver + (int) window;
+					});
+					if(stop || next > to){
+						break;
+					}
+					int height = next++;
+					guard.unlock();
+
+					blockinfo_t block = api.getBlock(api.getBlockHash(height));
+
+					guard.lock();
+					ready[height] = std::move(block);
+					changed.notify_all();
+				}
+			}
+			catch(...){
+				std::lock_guard<std::mutex> guard(lock);
+				if(!error){
+					error = std::current_exception();
+				}
+				stop = true;
+				changed.notify_all();
+			}
+		}));
+	}
+
+	try{
+		for(int height = from; height <= to; ++height){
+			blockinfo_t block;
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				changed.wait(guard, [&](){
+					return stop || ready.find(height) != ready.end();
+				});
+				if(stop){
+					break;
+				}
+				map<int, blockinfo_t>::iterator it = ready.find(height);
+				block = std::move(it->second);
+				ready.erase(it);
+				deliver = height + 1;
+				changed.notify_all();
+			}
+			consumer(block);
+		}
+	}
+	catch(...){
+		std::lock_guard<std::mutex> guard(lock);
+		if(!error){
+			error = std::current_exception();
+		}
+		stop = true;
+		changed.notify_all();
+	}
+
+	for(unsigned int t = 0; t < workers.size(); ++t){
+		workers[t].join();
+	}
+
+	if(error){
+		std::rethrow_exception(error);
+	}
+}
@@ -0,0 +1,41 @@
+/**
+ * @file    chainscanner.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of a block range scanner that keeps several
+ * getblockhash/getblock requests in flight and delivers
+ * the decoded blocks in height order.
+ */
+
+#ifndef RAPTOREUM_API_CHAINSCANNER_H
+#define RAPTOREUM_API_CHAINSCANNER_H
+
+#include "raptoreumapi.h"
+
+#include <functional>
+
+class ChainScanner
+{
+
+private:
+    RaptoreumAPI& rpc;
+    unsigned int connections;
+    unsigned int window;
+
+public:
+    /*
+     * connections: requests in flight, each worker opens its own connection
+     * window:      blocks fetched ahead of the consumer, bounds the reorder buffer
+     */
+    ChainScanner(RaptoreumAPI& rpc, unsigned int connections = 8, unsigned int window = 64);
+
+    // Fetches blocks [from, to] and hands each to consumer in height order,
+    // on the calling thread. Errors of workers or consumer stop the scan
+    // and are rethrown.
+    void scan(int from, int to, const std::function<void(const blockinfo_t&)>& consumer);
+};
+
+
+#endif
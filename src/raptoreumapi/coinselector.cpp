@@ -0,0 +1,322 @@
+/**
+ * @file    coinselector.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of a coin selection engine for large UTXO
+ * sets.
+ */
+
+#include "coinselector.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+/* Steps between clock reads, and the search limits of the reference wallet */
+static const unsigned int CLOCK_INTERVAL = 1024;
+static const unsigned int BNB_MAX_TRIES = 100000;
+static const unsigned int KNAPSACK_ITERATIONS = 1000;
+
+
+CoinSelector::CoinSelector(const vector<addressutxo_t>& utxos, int64_t feeRate, size_t inputSize)
+: inputFee((feeRate * (int64_t) inputSize + 999) / 1000),
+  available(0)
+{
+	vector<int64_t> amounts(utxos.size());
+	for(size_t i = 0; i < utxos.size(); ++i){
+		amounts[i] = utxos[i].satoshis;
+	}
+	load(amounts);
+}
+
+CoinSelector::CoinSelector(const vector<int64_t>& amounts, int64_t feeRate, size_t inputSize)
+: inputFee((feeRate * (int64_t) inputSize + 999) / 1000),
+  available(0)
+{
+	load(amounts);
+}
+
+void CoinSelector::load(const vector<int64_t>& amounts){
+	vector<uint32_t> order;
+	order.reserve(amounts.size());
+	for(size_t i = 0; i < amounts.size(); ++i){
+		if(amounts[i] > inputFee){
+			order.push_back((uint32_t) i);
+		}
+	}
+	std::sort(order.begin(), order.end(), [&amounts](uint32_t a, uint32_t b){
+		return amounts[a] > amounts[b];
+	});
+
+	/* Gathered once so the searches only walk contiguous arrays */
+	effective.resize(order.size());
+	values.resize(order.size());
+	indexes.swap(order);
+	for(size_t i = 0; i < indexes.size(); ++i){
+		values[i] = amounts[indexes[i]];
+		effective[i] = values[i] - inputFee;
+		available += effective[i];
+	}
+}
+
+void CoinSelector::result(const vector<uint32_t>& positions, const char * strategy, bool timedOut,
+                          coinselection_t& ret) const{
+	ret.selected.resize(positions.size());
+	ret.value = 0;
+	for(size_t i = 0; i < positions.size(); ++i){
+		ret.selected[i] = indexes[positions[i]];
+		ret.value += values[positions[i]];
+	}
+	ret.fee = inputFee * (int64_t) positions.size();
+	ret.strategy = strategy;
+	ret.timedOut = timedOut;
+}
+
+size_t CoinSelector::size() const{
+	return effective.size();
+}
+
+int64_t CoinSelector::getAvailable() const{
+	return available;
+}
+
+bool CoinSelector::selectBranchAndBound(int64_t target, int64_t costOfChange, coinselection_t& ret,
+                                        budget_t budget) const{
+	if(available < target){
+		return false;
+	}
+
+	const Clock::time_point deadline = Clock::now() + budget;
+	const size_t n = effective.size();
+	vector<uint32_t> selection, best;
+	int64_t bestExcess = std::numeric_limits<int64_t>::max();
+	int64_t value = 0;
+	int64_t remaining = available;      // sum of the undecided UTXOs, from next on
+	size_t next = 0;
+	bool timedOut = false;
+
+	for(unsigned int tries = 0; tries < BNB_MAX_TRIES; ++tries){
+		if(tries % CLOCK_INTERVAL == 0 && tries > 0 && Clock::now() > deadline){
+			timedOut = true;
+			break;
+		}
+
+		bool backtrack = false;
+		if(value + remaining < target || value > target + costOfChange){
+			backtrack = true;
+		}else if(value >= target){
+			if(value - target < bestExcess){
+				bestExcess = value - target;
+				best = selection;
+				if(bestExcess == 0){
+					break;
+				}
+			}
+			backtrack = true;
+		}
+
+		if(!backtrack){
+			/* Include next first, the exclusion branch is taken on the way back */
+			value += effective[next];
+			remaining -= effective[next];
+			selection.push_back((uint32_t) next);
+			++next;
+			continue;
+		}
+
+		if(selection.empty()){
+			break;
+		}
+
+		/* Exclude the last included UTXO; everything after it is undecided again */
+		size_t last = selection.back();
+		selection.pop_back();
+		value -= effective[last];
+		for(size_t i = last + 1; i < next; ++i){
+			remaining += effective[i];
+		}
+		next = last + 1;
+
+		/* Excluding it and taking an equal one gives the same sums */
+		while(next < n && effective[next] == effective[last]){
+			remaining -= effective[next];
+			++next;
+		}
+	}
+
+	if(best.empty()){
+		return false;
+	}
+	result(best, "branchandbound", timedOut, ret);
+	return true;
+}
+
+/* One repetition of the reference wallet's randomized subset search:
+ * the first pass includes values at random, the second the ones left
+ * out. Each time the total reaches target, onCross(pass, position, total)
+ * is told and the value is dropped again to look for a closer total.
+ * Returns early when tick or onCross return false. */
+template<typename Tick, typename Cross>
+static void knapsackTrial(const int64_t * values, size_t count, int64_t target, uint64_t seed,
+                          vector<char>& included, Tick tick, Cross onCross){
+	std::mt19937_64 rng(seed);
+	std::fill(included.begin(), included.end(), 0);
+	int64_t total = 0;
+	bool reached = false;
+
+	for(int pass = 0; pass < 2 && !reached; ++pass){
+		for(size_t i = 0; i < count; ++i){
+			if(!tick()){
+				return;
+			}
+			if(pass == 0 ? (rng() & 1) != 0 : !included[i]){
+				total += values[i];
+				included[i] = 1;
+				if(total >= target){
+					reached = true;
+					if(!onCross(pass, i, total)){
+						return;
+					}
+					total -= values[i];
+					included[i] = 0;
+				}
+			}
+		}
+	}
+}
+
+bool CoinSelector::selectKnapsack(int64_t target, coinselection_t& ret, budget_t budget) const{
+	if(available < target){
+		return false;
+	}
+
+	const Clock::time_point deadline = Clock::now() + budget;
+	vector<uint32_t> positions;
+
+	/* Sorted descending: the smaller UTXOs are a suffix and the lowest
+	 * larger one sits right before it */
+	size_t firstSmaller = std::lower_bound(effective.begin(), effective.end(), target,
+	                                       [](int64_t value, int64_t target){ return value > target; })
+	                      - effective.begin();
+	if(firstSmaller < effective.size() && effective[firstSmaller] == target){
+		positions.push_back((uint32_t) firstSmaller);
+		result(positions, "knapsack", false, ret);
+		return true;
+	}
+	bool haveLarger = firstSmaller > 0;
+	size_t lowestLarger = firstSmaller - 1;
+
+	int64_t smallerTotal = 0;
+	for(size_t i = firstSmaller; i < effective.size(); ++i){
+		smallerTotal += effective[i];
+	}
+
+	if(smallerTotal < target){
+		positions.push_back((uint32_t) lowestLarger);
+		result(positions, "knapsack", false, ret);
+		return true;
+	}
+	if(smallerTotal == target){
+		for(size_t i = firstSmaller; i < effective.size(); ++i){
+			positions.push_back((uint32_t) i);
+		}
+		result(positions, "knapsack", false, ret);
+		return true;
+	}
+
+	/* Approximate best subset of the smaller ones. Copying the inclusion
+	 * flags on every improvement would dominate on large sets, so only the
+	 * seed and position of the best crossing are kept and replayed. */
+	const int64_t * smaller = &effective[firstSmaller];
+	const size_t count = effective.size() - firstSmaller;
+	vector<char> included(count);
+	int64_t best = smallerTotal;
+	uint64_t baseSeed = std::random_device{}();
+	uint64_t bestSeed = 0;
+	int bestPass = -1;
+	size_t bestPos = 0;
+	bool timedOut = false;
+	unsigned long steps = 0;
+
+	for(unsigned int rep = 0; rep < KNAPSACK_ITERATIONS && best != target && !timedOut; ++rep){
+		knapsackTrial(smaller, count, target, baseSeed + rep, included,
+			[&](){
+				if(++steps % CLOCK_INTERVAL == 0 && Clock::now() > deadline){
+					timedOut = true;
+				}
+				return !timedOut;
+			},
+			[&](int pass, size_t i, int64_t total){
+				if(total < best){
+					best = total;
+					bestSeed = baseSeed + rep;
+					bestPass = pass;
+					bestPos = i;
+				}
+				return true;
+			});
+	}
+
+	if(bestPass >= 0){
+		knapsackTrial(smaller, count, target, bestSeed, included,
+			[](){ return true; },
+			[&](int pass, size_t i, int64_t total){
+				if(pass == bestPass && i == bestPos){
+					included[i] = 1;
+					return false;
+				}
+				return true;
+			});
+	}else{
+		std::fill(included.begin(), included.end(), 1);
+	}
+
+	if(haveLarger && best != target && effective[lowestLarger] <= best){
+		positions.push_back((uint32_t) lowestLarger);
+	}else{
+		for(size_t i = 0; i < count; ++i){
+			if(included[i]){
+				positions.push_back((uint32_t) (firstSmaller + i));
+			}
+		}
+	}
+	result(positions, "knapsack", timedOut, ret);
+	return true;
+}
+
+bool CoinSelector::selectLargestFirst(int64_t target, coinselection_t& ret) const{
+	if(available < target){
+		return false;
+	}
+
+	vector<uint32_t> positions;
+	int64_t total = 0;
+	for(size_t i = 0; i < effective.size() && total < target; ++i){
+		total += effective[i];
+		positions.push_back((uint32_t) i);
+	}
+
+	result(positions, "largestfirst", false, ret);
+	return true;
+}
+
+bool CoinSelector::select(int64_t target, int64_t costOfChange, coinselection_t& ret, budget_t budget) const{
+	const Clock::time_point start = Clock::now();
+
+	if(selectBranchAndBound(target, costOfChange, ret, budget / 2)){
+		return true;
+	}
+
+	budget_t left = budget - std::chrono::duration_cast<budget_t>(Clock::now() - start);
+	if(left > budget_t(0) && selectKnapsack(target, ret, left)){
+		return true;
+	}
+
+	return selectLargestFirst(target, ret);
+}
@@ -0,0 +1,79 @@
+/**
+ * @file    coinselector.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of a coin selection engine for large UTXO
+ * sets, with branch and bound, knapsack and largest first
+ * strategies under a time budget.
+ */
+
+#ifndef RAPTOREUM_API_COINSELECTOR_H
+#define RAPTOREUM_API_COINSELECTOR_H
+
+#include "types.h"
+
+#include <chrono>
+#include <stdint.h>
+
+struct coinselection_t{
+	std::vector<size_t> selected;   // indexes into the UTXOs given to the selector
+	int64_t value;                  // sum of the selected UTXOs
+	int64_t fee;                    // fee for spending them
+	const char * strategy;
+	bool timedOut;                  // the search was cut short, the result may not be the best
+};
+
+/*
+ * UTXOs are held as parallel arrays sorted by effective value (value
+ * minus the fee for spending it), largest first; ones that cost more to
+ * spend than they are worth are left out. Targets exclude input fees,
+ * i.e. they are the outputs plus the fee for the rest of the transaction.
+ */
+class CoinSelector
+{
+
+private:
+    std::vector<int64_t> effective;
+    std::vector<int64_t> values;
+    std::vector<uint32_t> indexes;
+    int64_t inputFee;
+    int64_t available;
+
+    void load(const std::vector<int64_t>& amounts);
+    void result(const std::vector<uint32_t>& positions, const char * strategy, bool timedOut,
+                coinselection_t& ret) const;
+
+public:
+    typedef std::chrono::microseconds budget_t;
+
+    // Size of a signed P2PKH input
+    static const size_t P2PKH_INPUT_SIZE = 148;
+
+    /* feeRate: satoshis per 1000 bytes */
+    CoinSelector(const std::vector<addressutxo_t>& utxos, int64_t feeRate, size_t inputSize = P2PKH_INPUT_SIZE);
+    CoinSelector(const std::vector<int64_t>& amounts, int64_t feeRate, size_t inputSize = P2PKH_INPUT_SIZE);
+
+    size_t size() const;
+    // Sum of the effective values
+    int64_t getAvailable() const;
+
+    // Depth first search for a selection within [target, target + costOfChange],
+    // so no change output is needed. The least excess wins.
+    bool selectBranchAndBound(int64_t target, int64_t costOfChange, coinselection_t& ret,
+                              budget_t budget = budget_t(10000)) const;
+
+    // Randomized subset sum approximation as in the reference wallet,
+    // aiming for the smallest total of at least target
+    bool selectKnapsack(int64_t target, coinselection_t& ret, budget_t budget = budget_t(10000)) const;
+
+    bool selectLargestFirst(int64_t target, coinselection_t& ret) const;
+
+    // Branch and bound, then knapsack, then largest first, sharing the budget
+    bool select(int64_t target, int64_t costOfChange, coinselection_t& ret,
+                budget_t budget = budget_t(20000)) const;
+};
+
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * @file    exception.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of error class for the JSON-RPC wrapper.
+ */
+
+#include "exception.h"
+#include "jsonscanner.h"
+
+#include <cctype>
+
+using std::string;
+
+/* Only codes named in rpcerror are cast to it */
+static rpcerror namedError(int code){
+	switch(code){
+	case RPC_INVALID_REQUEST: case RPC_METHOD_NOT_FOUND: case RPC_INVALID_PARAMS:
+	case RPC_INTERNAL_ERROR: case RPC_PARSE_ERROR:
+	case RPC_MISC_ERROR: case RPC_TYPE_ERROR: case RPC_INVALID_ADDRESS_OR_KEY:
+	case RPC_OUT_OF_MEMORY: case RPC_INVALID_PARAMETER: case RPC_DATABASE_ERROR:
+	case RPC_DESERIALIZATION_ERROR: case RPC_VERIFY_ERROR: case RPC_VERIFY_REJECTED:
+	case RPC_VERIFY_ALREADY_IN_CHAIN: case RPC_IN_WARMUP: case RPC_METHOD_DEPRECATED:
+	case RPC_CLIENT_NOT_CONNECTED: case RPC_CLIENT_IN_INITIAL_DOWNLOAD:
+	case RPC_CLIENT_NODE_ALREADY_ADDED: case RPC_CLIENT_NODE_NOT_ADDED:
+	case RPC_CLIENT_NODE_NOT_CONNECTED: case RPC_CLIENT_INVALID_IP_OR_SUBNET:
+	case RPC_CLIENT_P2P_DISABLED:
+	case RPC_WALLET_ERROR: case RPC_WALLET_INSUFFICIENT_FUNDS: case RPC_WALLET_INVALID_LABEL_NAME:
+	case RPC_WALLET_KEYPOOL_RAN_OUT: case RPC_WALLET_UNLOCK_NEEDED: case RPC_WALLET_PASSPHRASE_INCORRECT:
+	case RPC_WALLET_WRONG_ENC_STATE: case RPC_WALLET_ENCRYPTION_FAILED: case RPC_WALLET_ALREADY_UNLOCKED:
+	case RPC_WALLET_NOT_FOUND: case RPC_WALLET_NOT_SPECIFIED:
+	case RPC_CONNECTION_ERROR: case RPC_INVALID_RESPONSE: case RPC_AUTHENTICATION_FAILED:
+	case RPC_REORG_TOO_DEEP:
+		return (rpcerror) code;
+	default:
+		return RPC_MISC_ERROR;
+	}
+}
+
+
+RaptoreumException::RaptoreumException(int errcode, const string& message)
+: code(errcode),
+  error(namedError(errcode))
+{
+	/* Connection error */
+	if(errcode == Errors::ERROR_CLIENT_CONNECTOR){
+		msg = removePrefix(message, " -> ");
+		return;
+	}
+	/* Malformed response, or another error found on the client side. The
+	   daemon's own codes, outside the JSON-RPC range, are only thrown
+	   here by local checks, e.g. for an invalid address. */
+	if(errcode == Errors::ERROR_CLIENT_INVALID_RESPONSE || errcode == RPC_REORG_TOO_DEEP || errcode > -32000){
+		msg = message;
+		return;
+	}
+
+	string body = removePrefix(message, "INTERNAL_ERROR: : ");
+
+	/* Authentication error, answered without a body */
+	if(errcode == Errors::ERROR_RPC_INTERNAL_ERROR && body.empty()){
+		error = RPC_AUTHENTICATION_FAILED;
+		msg = "Failed to authenticate successfully";
+		return;
+	}
+
+	/* Miscellaneous error, the body is the daemon's response */
+	try{
+		JsonScanner scanner(body);
+		string key;
+
+		if(scanner.beginObject()){
+			while(scanner.nextMember(key)){
+				if(key != "error"){
+					scanner.skipValue();
+				}else if(!scanner.isNull()){
+					*this = fromErrorObject(scanner);
+					return;
+				}
+			}
+		}
+	}
+	catch(RaptoreumException& e){
+	}
+
+	code = -1;
+	error = RPC_MISC_ERROR;
+	msg = "Error during parsing of >>" + body + "<<";
+}
+
+RaptoreumException::RaptoreumException(const Value& error){
+	setDaemonError(error["code"].asInt(), error["message"].asString());
+}
+
+RaptoreumException RaptoreumException::fromErrorObject(JsonScanner& scanner){
+	RaptoreumException ret;
+	int errcode = 0;
+	string message;
+	string key;
+
+	scanner.beginObject();
+	while(scanner.nextMember(key)){
+		if(key == "code"){
+			errcode = (int) scanner.readInt();
+		}else if(key == "message"){
+			scanner.readString(message);
+		}else{
+			scanner.skipValue();
+		}
+	}
+
+	ret.setDaemonError(errcode, message);
+	return ret;
+}
+
+void RaptoreumException::setDaemonError(int errcode, const string& message){
+	code = errcode;
+	error = namedError(errcode);
+	msg = removePrefix(message, "Error: ");
+	if(!msg.empty()){
+		msg[0] = toupper(msg[0]);
+	}
+}
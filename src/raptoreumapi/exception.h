@@ -23,41 +23,106 @@ using Json::Value;
 using Json::Reader;
 using jsonrpc::Errors;
 
+class JsonScanner;
+
+/* Error codes of the daemon's RPC interface and of the client side */
+enum rpcerror{
+	/* Standard JSON-RPC errors */
+	RPC_INVALID_REQUEST = -32600,
+	RPC_METHOD_NOT_FOUND = -32601,
+	RPC_INVALID_PARAMS = -32602,
+	RPC_INTERNAL_ERROR = -32603,
+	RPC_PARSE_ERROR = -32700,
+
+	/* General application defined errors */
+	RPC_MISC_ERROR = -1,
+	RPC_TYPE_ERROR = -3,
+	RPC_INVALID_ADDRESS_OR_KEY = -5,
+	RPC_OUT_OF_MEMORY = -7,
+	RPC_INVALID_PARAMETER = -8,
+	RPC_DATABASE_ERROR = -20,
+	RPC_DESERIALIZATION_ERROR = -22,
+	RPC_VERIFY_ERROR = -25,
+	RPC_VERIFY_REJECTED = -26,
+	RPC_VERIFY_ALREADY_IN_CHAIN = -27,
+	RPC_IN_WARMUP = -28,
+	RPC_METHOD_DEPRECATED = -32,
+
+	/* P2P client errors */
+	RPC_CLIENT_NOT_CONNECTED = -9,
+	RPC_CLIENT_IN_INITIAL_DOWNLOAD = -10,
+	RPC_CLIENT_NODE_ALREADY_ADDED = -23,
+	RPC_CLIENT_NODE_NOT_ADDED = -24,
+	RPC_CLIENT_NODE_NOT_CONNECTED = -29,
+	RPC_CLIENT_INVALID_IP_OR_SUBNET = -30,
+	RPC_CLIENT_P2P_DISABLED = -31,
+
+	/* Wallet errors */
+	RPC_WALLET_ERROR = -4,
+	RPC_WALLET_INSUFFICIENT_FUNDS = -6,
+	RPC_WALLET_INVALID_LABEL_NAME = -11,
+	RPC_WALLET_KEYPOOL_RAN_OUT = -12,
+	RPC_WALLET_UNLOCK_NEEDED = -13,
+	RPC_WALLET_PASSPHRASE_INCORRECT = -14,
+	RPC_WALLET_WRONG_ENC_STATE = -15,
+	RPC_WALLET_ENCRYPTION_FAILED = -16,
+	RPC_WALLET_ALREADY_UNLOCKED = -17,
+	RPC_WALLET_NOT_FOUND = -18,
+	RPC_WALLET_NOT_SPECIFIED = -19,
+
+	/* Client side, in the range JSON-RPC reserves for implementations: no
+	   connection, a malformed response, with getCode() still
+	   ERROR_RPC_INTERNAL_ERROR rejected credentials, and a reorganization
+	   deeper than a ChainFollower's window */
+	RPC_CONNECTION_ERROR = -32003,
+	RPC_INVALID_RESPONSE = -32001,
+	RPC_AUTHENTICATION_FAILED = -32010,
+	RPC_REORG_TOO_DEEP = -32011
+};
+
 
 class RaptoreumException: public std::exception
 {
 private:
 	int code;
+	rpcerror error;
 	std::string msg;
 
+	RaptoreumException() : code(0), error(RPC_MISC_ERROR) { }
+	friend class RpcError;
+
+	void setDaemonError(int errcode, const std::string& message);
+
 public:
-	explicit RaptoreumException(int errcode, const std::string& message) {
-		
-		/* Connection error */
-		if(errcode == Errors::ERROR_CLIENT_CONNECTOR){
-			this->code = errcode;
-			this->msg = removePrefix(message, " -> ");		
-		/* Authentication error */
-		}else if(errcode == Errors::ERROR_RPC_INTERNAL_ERROR && message.size() == 18){
-			this->code = errcode;
-			this->msg = "Failed to authenticate successfully";
-		/* Miscellaneous error */
-		}else{
-			this->code = parseCode(message);
-			this->msg = parseMessage(message);
-		}
-	}
+	/* Error of the RPC client, or an HTTP error whose body holds the
+	   daemon's error object after an "INTERNAL_ERROR: : " prefix */
+	explicit RaptoreumException(int errcode, const std::string& message);
+
+	/* Error object of a call, e.g. inside a batch response */
+	explicit RaptoreumException(const Value& error);
+
+	/* Error object read from scanner, which is at its opening brace */
+	static RaptoreumException fromErrorObject(JsonScanner& scanner);
 
 	~RaptoreumException() throw() { };
 
-	int getCode(){
+	int getCode() const{
 		return code;
 	}
 
-	std::string getMessage(){
+	// getCode() as a named error, RPC_MISC_ERROR for any other code
+	rpcerror getError() const{
+		return error;
+	}
+
+	std::string getMessage() const{
 		return msg;
 	}
 
+	const char * what() const throw(){
+		return msg.c_str();
+	}
+
 
 	std::string removePrefix(const std::string& in, const std::string& pattern){
 		std::string ret = in;
@@ -70,42 +135,6 @@ public:
 
 		return ret;
 	}
-
-	/* Auxiliary JSON parsing */
-	int parseCode(const std::string& in){
-		Value root;
-		Reader reader;
-
-		/* Remove JSON prefix */
-		std::string strJson = removePrefix(in, "INTERNAL_ERROR: : ");
-		int ret = -1;
-
-		/* Parse error message */
-		bool parsingSuccessful = reader.parse(strJson.c_str(), root);
-		if(parsingSuccessful) {
-			ret = root["error"]["code"].asInt();
-		}
-
-		return ret;
-	}
-
-	std::string parseMessage(const std::string& in){
-		Value root;
-		Reader reader;
-
-		/* Remove JSON prefix */
-		std::string strJson = removePrefix(in, "INTERNAL_ERROR: : ");
-		std::string ret = "Error during parsing of >>" + strJson + "<<";
-
-		/* Parse error message */
-		bool parsingSuccessful = reader.parse(strJson.c_str(), root);
-		if(parsingSuccessful) {
-			ret = removePrefix(root["error"]["message"].asString(), "Error: ");
-			ret[0] = toupper(ret[0]);
-		}
-
-		return ret;
-	}
 };
 
 #endif
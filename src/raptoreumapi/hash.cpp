@@ -0,0 +1,593 @@
+/**
+ * @file    hash.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * SHA-256 and RIPEMD-160 as used for transaction ids,
+ * block hashes and addresses. SHA-256 uses the SHA extensions
+ * where available; otherwise batches of double SHA-256 are
+ * hashed eight at a time with AVX2.
+ */
+
+#include "hash.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HASH_USE_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+
+static inline uint32_t readBE32(const unsigned char * p){
+	return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+static inline void writeBE32(unsigned char * p, uint32_t x){
+	p[0] = x >> 24; p[1] = x >> 16; p[2] = x >> 8; p[3] = x;
+}
+
+static inline void writeBE64(unsigned char * p, uint64_t x){
+	writeBE32(p, x >> 32);
+	writeBE32(p + 4, (uint32_t) x);
+}
+
+static inline uint32_t readLE32(const unsigned char * p){
+	return ((uint32_t) p[3] << 24) | ((uint32_t) p[2] << 16) | ((uint32_t) p[1] << 8) | p[0];
+}
+
+static inline void writeLE32(unsigned char * p, uint32_t x){
+	p[0] = x; p[1] = x >> 8; p[2] = x >> 16; p[3] = x >> 24;
+}
+
+static inline uint32_t rotr(uint32_t x, int n){
+	return (x >> n) | (x << (32 - n));
+}
+
+static inline uint32_t rotl(uint32_t x, int n){
+	return (x << n) | (x >> (32 - n));
+}
+
+/* === SHA-256 === */
+
+static const uint32_t sha256K[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t sha256Init[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static void sha256TransformScalar(uint32_t * s, const unsigned char * chunk, size_t blocks){
+	while(blocks--){
+		uint32_t w[64];
+		for(int i = 0; i < 16; ++i){
+			w[i] = readBE32(chunk + 4 * i);
+		}
+		for(int i = 16; i < 64; ++i){
+			uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+
+		uint32_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+		for(int i = 0; i < 64; ++i){
+			uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + sha256K[i] + w[i];
+			uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+			h = g; g = f; f = e; e = d + t1;
+			d = c; c = b; b = a; a = t1 + t2;
+		}
+
+		s[0] += a; s[1] += b; s[2] += c; s[3] += d;
+		s[4] += e; s[5] += f; s[6] += g; s[7] += h;
+		chunk += 64;
+	}
+}
+
+#ifdef HASH_USE_X86
+
+/* === SHA-NI === */
+
+/* Follows Intel's reference: the state is kept as ABEF/CDGH, each
+ * sha256rnds2 does two rounds and msg1/msg2 extend the schedule */
+__attribute__((target("sha,sse4.1")))
+static void sha256TransformShani(uint32_t * s, const unsigned char * chunk, size_t blocks){
+	const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+	__m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &s[0]), 0xB1);
+	__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &s[4]), 0x1B);
+	__m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+	while(blocks--){
+		const __m128i abefSave = state0;
+		const __m128i cdghSave = state1;
+		__m128i msgs[4];
+
+		for(int i = 0; i < 16; ++i){
+			if(i < 4){
+				msgs[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (chunk + 16 * i)), mask);
+			}
+			__m128i msg = _mm_add_epi32(msgs[i & 3], _mm_loadu_si128((const __m128i *) &sha256K[4 * i]));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			if(i >= 3 && i <= 14){
+				tmp = _mm_alignr_epi8(msgs[i & 3], msgs[(i - 1) & 3], 4);
+				msgs[(i + 1) & 3] = _mm_add_epi32(msgs[(i + 1) & 3], tmp);
+				msgs[(i + 1) & 3] = _mm_sha256msg2_epu32(msgs[(i + 1) & 3], msgs[i & 3]);
+			}
+			msg = _mm_shuffle_epi32(msg, 0x0E);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+			if(i >= 1 && i <= 12){
+				msgs[(i - 1) & 3] = _mm_sha256msg1_epu32(msgs[(i - 1) & 3], msgs[i & 3]);
+			}
+		}
+
+		state0 = _mm_add_epi32(state0, abefSave);
+		state1 = _mm_add_epi32(state1, cdghSave);
+		chunk += 64;
+	}
+
+	tmp = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+	state1 = _mm_alignr_epi8(state1, tmp, 8);
+	_mm_storeu_si128((__m128i *) &s[0], state0);
+	_mm_storeu_si128((__m128i *) &s[4], state1);
+}
+
+/* === AVX2, eight messages at once === */
+
+#define ROTR8(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+/* states[word][lane], one 64 byte block per lane */
+__attribute__((target("avx2")))
+static void sha256Transform8(uint32_t states[8][8], const unsigned char * const chunks[8]){
+	const __m256i bswap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+	                                      12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+	__m256i w[16];
+
+	/* Load each lane's block and transpose so w[i] holds word i of all lanes */
+	for(int half = 0; half < 2; ++half){
+		__m256i r[8], t[8], u[8];
+		for(int lane = 0; lane < 8; ++lane){
+			r[lane] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *) (chunks[lane] + 32 * half)), bswap);
+		}
+		for(int k = 0; k < 8; k += 2){
+			t[k] = _mm256_unpacklo_epi32(r[k], r[k + 1]);
+			t[k + 1] = _mm256_unpackhi_epi32(r[k], r[k + 1]);
+		}
+		for(int k = 0; k < 8; k += 4){
+			u[k] = _mm256_unpacklo_epi64(t[k], t[k + 2]);
+			u[k + 1] = _mm256_unpackhi_epi64(t[k], t[k + 2]);
+			u[k + 2] = _mm256_unpacklo_epi64(t[k + 1], t[k + 3]);
+			u[k + 3] = _mm256_unpackhi_epi64(t[k + 1], t[k + 3]);
+		}
+		for(int k = 0; k < 4; ++k){
+			w[8 * half + k] = _mm256_permute2x128_si256(u[k], u[k + 4], 0x20);
+			w[8 * half + k + 4] = _mm256_permute2x128_si256(u[k], u[k + 4], 0x31);
+		}
+	}
+
+	__m256i a = _mm256_load_si256((const __m256i *) states[0]);
+	__m256i b = _mm256_load_si256((const __m256i *) states[1]);
+	__m256i c = _mm256_load_si256((const __m256i *) states[2]);
+	__m256i d = _mm256_load_si256((const __m256i *) states[3]);
+	__m256i e = _mm256_load_si256((const __m256i *) states[4]);
+	__m256i f = _mm256_load_si256((const __m256i *) states[5]);
+	__m256i g = _mm256_load_si256((const __m256i *) states[6]);
+	__m256i h = _mm256_load_si256((const __m256i *) states[7]);
+
+	for(int i = 0; i < 64; ++i){
+		if(i >= 16){
+			const __m256i w15 = w[(i + 1) & 15], w2 = w[(i + 14) & 15];
+			const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(w15, 7), ROTR8(w15, 18)), _mm256_srli_epi32(w15, 3));
+			const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(w2, 17), ROTR8(w2, 19)), _mm256_srli_epi32(w2, 10));
+			w[i & 15] = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], s0), _mm256_add_epi32(w[(i + 9) & 15], s1));
+		}
+
+		const __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(e, 6), ROTR8(e, 11)), ROTR8(e, 25));
+		const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+		const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, sigma1),
+		                   _mm256_add_epi32(_mm256_add_epi32(ch, _mm256_set1_epi32(sha256K[i])), w[i & 15]));
+		const __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(a, 2), ROTR8(a, 13)), ROTR8(a, 22));
+		const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+		const __m256i t2 = _mm256_add_epi32(sigma0, maj);
+
+		h = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+		d = c; c = b; b = a; a = _mm256_add_epi32(t1, t2);
+	}
+
+	const __m256i result[8] = { a, b, c, d, e, f, g, h };
+	for(int i = 0; i < 8; ++i){
+		__m256i v = _mm256_load_si256((const __m256i *) states[i]);
+		_mm256_store_si256((__m256i *) states[i], _mm256_add_epi32(v, result[i]));
+	}
+}
+
+#undef ROTR8
+
+#endif
+
+/* === Dispatch === */
+
+typedef void (*sha256transform_t)(uint32_t *, const unsigned char *, size_t);
+
+struct sha256kernels_t{
+	sha256transform_t transform;
+	bool multiBuffer;
+	const char * name;
+	bool sha;
+	bool avx2;
+
+	sha256kernels_t()
+	: transform(sha256TransformScalar), multiBuffer(false), name("scalar"), sha(false), avx2(false)
+	{
+#ifdef HASH_USE_X86
+		unsigned int eax, ebx, ecx, edx;
+		__builtin_cpu_init();
+		sha = __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1 << 29))
+		      && __builtin_cpu_supports("sse4.1");
+		avx2 = __builtin_cpu_supports("avx2");
+#endif
+		select("");
+	}
+
+	/* "" picks the fastest kernel this CPU supports */
+	bool select(const char * wanted){
+		if(*wanted == '\0'){
+			wanted = sha ? "shani" : (avx2 ? "avx2" : "scalar");
+		}
+		if(std::strcmp(wanted, "scalar") == 0){
+			transform = sha256TransformScalar;
+			multiBuffer = false;
+			name = "scalar";
+			return true;
+		}
+#ifdef HASH_USE_X86
+		if(std::strcmp(wanted, "shani") == 0 && sha){
+			transform = sha256TransformShani;
+			multiBuffer = false;
+			name = "shani";
+			return true;
+		}
+		if(std::strcmp(wanted, "avx2") == 0 && avx2){
+			transform = sha256TransformScalar;
+			multiBuffer = true;
+			name = "avx2";
+			return true;
+		}
+#endif
+		return false;
+	}
+};
+
+static sha256kernels_t& sha256Kernels(){
+	static sha256kernels_t instance;
+	return instance;
+}
+
+static void sha256Transform(uint32_t * s, const unsigned char * chunk, size_t blocks){
+	sha256Kernels().transform(s, chunk, blocks);
+}
+
+Sha256::Sha256(){
+	reset();
+}
+
+Sha256& Sha256::reset(){
+	std::memcpy(s, sha256Init, sizeof(s));
+	bytes = 0;
+	return *this;
+}
+
+Sha256& Sha256::write(const unsigned char * data, size_t len){
+	size_t used = bytes % 64;
+	bytes += len;
+
+	if(used > 0){
+		size_t fill = (len < 64 - used) ? len : 64 - used;
+		std::memcpy(buf + used, data, fill);
+		data += fill;
+		len -= fill;
+		if(used + fill < 64){
+			return *this;
+		}
+		sha256Transform(s, buf, 1);
+	}
+
+	/* Whole blocks straight from the input */
+	sha256Transform(s, data, len / 64);
+	data += len - len % 64;
+	std::memcpy(buf, data, len % 64);
+
+	return *this;
+}
+
+void Sha256::finalize(unsigned char hash[OUTPUT_SIZE]){
+	static const unsigned char pad[64] = { 0x80 };
+	unsigned char length[8];
+	writeBE64(length, bytes << 3);
+
+	write(pad, 1 + ((119 - (bytes % 64)) % 64));
+	write(length, 8);
+
+	for(int i = 0; i < 8; ++i){
+		writeBE32(hash + 4 * i, s[i]);
+	}
+}
+
+/* === RIPEMD-160 === */
+
+static const unsigned char ripemdLeftWord[80] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+	3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+	1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+	4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13
+};
+
+static const unsigned char ripemdRightWord[80] = {
+	5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+	6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+	15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+	8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+	12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11
+};
+
+static const unsigned char ripemdLeftShift[80] = {
+	11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+	7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+	11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+	11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+	9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6
+};
+
+static const unsigned char ripemdRightShift[80] = {
+	8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+	9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+	9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+	15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+	8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11
+};
+
+static const uint32_t ripemdLeftK[5] = { 0x00000000, 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xA953FD4E };
+static const uint32_t ripemdRightK[5] = { 0x50A28BE6, 0x5C4DD124, 0x6D703EF3, 0x7A6D76E9, 0x00000000 };
+
+static inline uint32_t ripemdF(int round, uint32_t x, uint32_t y, uint32_t z){
+	switch(round){
+	case 0: return x ^ y ^ z;
+	case 1: return (x & y) | (~x & z);
+	case 2: return (x | ~y) ^ z;
+	case 3: return (x & z) | (y & ~z);
+	default: return x ^ (y | ~z);
+	}
+}
+
+static void ripemd160Transform(uint32_t * s, const unsigned char * chunk, size_t blocks){
+	while(blocks--){
+		uint32_t w[16];
+		for(int i = 0; i < 16; ++i){
+			w[i] = readLE32(chunk + 4 * i);
+		}
+
+		uint32_t al = s[0], bl = s[1], cl = s[2], dl = s[3], el = s[4];
+		uint32_t ar = s[0], br = s[1], cr = s[2], dr = s[3], er = s[4];
+
+		for(int j = 0; j < 80; ++j){
+			int round = j / 16;
+
+			uint32_t t = rotl(al + ripemdF(round, bl, cl, dl) + w[ripemdLeftWord[j]] + ripemdLeftK[round],
+			                  ripemdLeftShift[j]) + el;
+			al = el; el = dl; dl = rotl(cl, 10); cl = bl; bl = t;
+
+			t = rotl(ar + ripemdF(4 - round, br, cr, dr) + w[ripemdRightWord[j]] + ripemdRightK[round],
+			         ripemdRightShift[j]) + er;
+			ar = er; er = dr; dr = rotl(cr, 10); cr = br; br = t;
+		}
+
+		uint32_t t = s[1] + cl + dr;
+		s[1] = s[2] + dl + er;
+		s[2] = s[3] + el + ar;
+		s[3] = s[4] + al + br;
+		s[4] = s[0] + bl + cr;
+		s[0] = t;
+		chunk += 64;
+	}
+}
+
+Ripemd160::Ripemd160(){
+	reset();
+}
+
+Ripemd160& Ripemd160::reset(){
+	s[0] = 0x67452301; s[1] = 0xEFCDAB89; s[2] = 0x98BADCFE; s[3] = 0x10325476; s[4] = 0xC3D2E1F0;
+	bytes = 0;
+	return *this;
+}
+
+Ripemd160& Ripemd160::write(const unsigned char * data, size_t len){
+	size_t used = bytes % 64;
+	bytes += len;
+
+	if(used > 0){
+		size_t fill = (len < 64 - used) ? len : 64 - used;
+		std::memcpy(buf + used, data, fill);
+		data += fill;
+		len -= fill;
+		if(used + fill < 64){
+			return *this;
+		}
+		ripemd160Transform(s, buf, 1);
+	}
+
+	ripemd160Transform(s, data, len / 64);
+	data += len - len % 64;
+	std::memcpy(buf, data, len % 64);
+
+	return *this;
+}
+
+void Ripemd160::finalize(unsigned char hash[OUTPUT_SIZE]){
+	static const unsigned char pad[64] = { 0x80 };
+	unsigned char length[8];
+	writeLE32(length, (uint32_t) (bytes << 3));
+	writeLE32(length + 4, (uint32_t) (bytes >> 29));
+
+	write(pad, 1 + ((119 - (bytes % 64)) % 64));
+	write(length, 8);
+
+	for(int i = 0; i < 5; ++i){
+		writeLE32(hash + 4 * i, s[i]);
+	}
+}
+
+/* === Helpers === */
+
+void DoubleSha256(const unsigned char * data, size_t len, unsigned char hash[32]){
+	unsigned char tmp[Sha256::OUTPUT_SIZE];
+	Sha256().write(data, len).finalize(tmp);
+	Sha256().write(tmp, sizeof(tmp)).finalize(hash);
+}
+
+void Hash160(const unsigned char * data, size_t len, unsigned char hash[20]){
+	unsigned char tmp[Sha256::OUTPUT_SIZE];
+	Sha256().write(data, len).finalize(tmp);
+	Ripemd160().write(tmp, sizeof(tmp)).finalize(hash);
+}
+
+/* === Batches === */
+
+#ifdef HASH_USE_X86
+
+/* One message in flight in a lane of the eight way transform */
+struct sha256lane_t{
+	size_t message;
+	const unsigned char * data;
+	size_t fullBlocks;          // blocks read straight from data
+	size_t blocks;              // total blocks of the current pass
+	size_t block;
+	bool second;                // hashing the first digest
+	unsigned char tail[128];    // padded final blocks
+};
+
+static void padTail(sha256lane_t& lane, const unsigned char * rest, size_t restLen, uint64_t totalLen){
+	size_t tailBlocks = (restLen + 9 + 63) / 64;
+	std::memset(lane.tail, 0, 64 * tailBlocks);
+	std::memcpy(lane.tail, rest, restLen);
+	lane.tail[restLen] = 0x80;
+	writeBE64(lane.tail + 64 * tailBlocks - 8, totalLen << 3);
+	lane.blocks = lane.fullBlocks + tailBlocks;
+	lane.block = 0;
+}
+
+static void laneState(uint32_t states[8][8], int lane, const uint32_t * s){
+	for(int i = 0; i < 8; ++i){
+		states[i][lane] = s[i];
+	}
+}
+
+/* Lanes pick up the next message as soon as theirs is done, so
+ * messages of different lengths keep all eight lanes busy */
+static void doubleSha256Multi(size_t count, const unsigned char * const * data, const size_t * lens,
+                              unsigned char * hashes){
+	static const unsigned char idle[64] = { 0 };
+	alignas(32) uint32_t states[8][8];
+	sha256lane_t lanes[8];
+	bool active[8];
+	size_t next = 0;
+	int running = 0;
+
+	for(int l = 0; l < 8; ++l){
+		active[l] = false;
+	}
+
+	while(true){
+		/* Refill idle lanes */
+		for(int l = 0; l < 8 && next < count; ++l){
+			if(active[l]){
+				continue;
+			}
+			sha256lane_t& lane = lanes[l];
+			lane.message = next;
+			lane.data = data[next];
+			lane.fullBlocks = lens[next] / 64;
+			lane.second = false;
+			padTail(lane, data[next] + 64 * lane.fullBlocks, lens[next] % 64, lens[next]);
+			laneState(states, l, sha256Init);
+			active[l] = true;
+			++running;
+			++next;
+		}
+		if(running == 0){
+			break;
+		}
+
+		const unsigned char * chunks[8];
+		for(int l = 0; l < 8; ++l){
+			const sha256lane_t& lane = lanes[l];
+			if(!active[l]){
+				chunks[l] = idle;
+			}else if(lane.block < lane.fullBlocks){
+				chunks[l] = lane.data + 64 * lane.block;
+			}else{
+				chunks[l] = lane.tail + 64 * (lane.block - lane.fullBlocks);
+			}
+		}
+
+		sha256Transform8(states, chunks);
+
+		for(int l = 0; l < 8; ++l){
+			sha256lane_t& lane = lanes[l];
+			if(!active[l] || ++lane.block < lane.blocks){
+				continue;
+			}
+
+			unsigned char digest[32];
+			for(int i = 0; i < 8; ++i){
+				writeBE32(digest + 4 * i, states[i][l]);
+			}
+
+			if(!lane.second){
+				lane.second = true;
+				lane.fullBlocks = 0;
+				padTail(lane, digest, sizeof(digest), sizeof(digest));
+				laneState(states, l, sha256Init);
+			}else{
+				std::memcpy(hashes + 32 * lane.message, digest, sizeof(digest));
+				active[l] = false;
+				--running;
+			}
+		}
+	}
+}
+
+#endif
+
+const char * Sha256Implementation(){
+	return sha256Kernels().name;
+}
+
+bool SetSha256Implementation(const char * name){
+	return sha256Kernels().select(name);
+}
+
+void DoubleSha256Batch(size_t count, const unsigned char * const * data, const size_t * lens, unsigned char * hashes){
+#ifdef HASH_USE_X86
+	if(sha256Kernels().multiBuffer && count > 1){
+		doubleSha256Multi(count, data, lens, hashes);
+		return;
+	}
+#endif
+	for(size_t i = 0; i < count; ++i){
+		DoubleSha256(data[i], lens[i], hashes + 32 * i);
+	}
+}
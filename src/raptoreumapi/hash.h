@@ -0,0 +1,73 @@
+/**
+ * @file    hash.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * SHA-256 and RIPEMD-160 as used for transaction ids,
+ * block hashes and addresses, accelerated with the SHA
+ * extensions or AVX2 where the CPU supports them.
+ */
+
+#ifndef RAPTOREUM_API_HASH_H
+#define RAPTOREUM_API_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Sha256
+{
+
+private:
+    uint32_t s[8];
+    unsigned char buf[64];
+    uint64_t bytes;
+
+public:
+    static const size_t OUTPUT_SIZE = 32;
+
+    Sha256();
+    Sha256& write(const unsigned char * data, size_t len);
+    void finalize(unsigned char hash[OUTPUT_SIZE]);
+    Sha256& reset();
+};
+
+class Ripemd160
+{
+
+private:
+    uint32_t s[5];
+    unsigned char buf[64];
+    uint64_t bytes;
+
+public:
+    static const size_t OUTPUT_SIZE = 20;
+
+    Ripemd160();
+    Ripemd160& write(const unsigned char * data, size_t len);
+    void finalize(unsigned char hash[OUTPUT_SIZE]);
+    Ripemd160& reset();
+};
+
+// SHA-256 applied twice, as for txids, block hashes and checksums
+void DoubleSha256(const unsigned char * data, size_t len, unsigned char hash[32]);
+
+// RIPEMD-160 of SHA-256, as for addresses
+void Hash160(const unsigned char * data, size_t len, unsigned char hash[20]);
+
+// Double SHA-256 of count messages, the hash of data[i] (lens[i] bytes)
+// is written to hashes + 32 * i. Without SHA extensions the messages
+// are hashed eight at a time with AVX2 where available.
+void DoubleSha256Batch(size_t count, const unsigned char * const * data, const size_t * lens,
+                       unsigned char * hashes);
+
+// Name of the SHA-256 kernel selected for this CPU: "shani", "avx2" or "scalar"
+const char * Sha256Implementation();
+
+// Switches to the named kernel, "" for the fastest one this CPU supports.
+// False, keeping the current kernel, if the CPU lacks it. For tests and
+// benchmarks: no other thread may be hashing meanwhile.
+bool SetSha256Implementation(const char * name);
+
+
+#endif
@@ -0,0 +1,286 @@
+/**
+ * @file    hex.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Conversion between hex strings and binary data. On x86 the
+ * bulk of the work is done by SSSE3 or AVX2 kernels, chosen
+ * once at runtime, with the scalar code handling the tails.
+ */
+
+#include "hex.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HEX_USE_X86 1
+#include <immintrin.h>
+#endif
+
+using std::string;
+using std::vector;
+
+
+static const char hexDigits[] = "0123456789abcdef";
+
+static inline int hexValue(char c){
+	if(c >= '0' && c <= '9') return c - '0';
+	if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+	if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+	return -1;
+}
+
+/* === Scalar kernels === */
+
+static bool hexDecodeScalar(const char * hex, size_t len, unsigned char * out){
+	for(size_t i = 0; i < len; ++i){
+		int hi = hexValue(hex[2 * i]);
+		int lo = hexValue(hex[2 * i + 1]);
+		if((hi | lo) < 0){
+			return false;
+		}
+		out[i] = (unsigned char) ((hi << 4) | lo);
+	}
+	return true;
+}
+
+static void hexEncodeScalar(const unsigned char * data, size_t len, char * out){
+	for(size_t i = 0; i < len; ++i){
+		out[2 * i] = hexDigits[data[i] >> 4];
+		out[2 * i + 1] = hexDigits[data[i] & 0x0F];
+	}
+}
+
+#ifdef HEX_USE_X86
+
+/* === SSSE3 kernels === */
+
+/* Maps 16 characters to their nibble values, false if any is not a hex digit */
+__attribute__((target("ssse3")))
+static inline bool nibbles128(__m128i c, __m128i& out){
+	const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+	const __m128i alpha = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+	const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+	const __m128i isAlpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+	out = _mm_or_si128(_mm_and_si128(isDigit, digit),
+	                   _mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+	return _mm_movemask_epi8(_mm_or_si128(isDigit, isAlpha)) == 0xFFFF;
+}
+
+__attribute__((target("ssse3")))
+static bool hexDecodeSsse3(const char * hex, size_t len, unsigned char * out){
+	/* Pairs of nibbles are joined as hi * 16 + lo by maddubs */
+	const __m128i weights = _mm_set1_epi16(0x0110);
+	size_t i = 0;
+
+	for(; i + 16 <= len; i += 16){
+		__m128i n0, n1;
+		bool ok = nibbles128(_mm_loadu_si128((const __m128i *) (hex + 2 * i)), n0);
+		ok &= nibbles128(_mm_loadu_si128((const __m128i *) (hex + 2 * i + 16)), n1);
+		if(!ok){
+			return false;
+		}
+		const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(n0, weights),
+		                                       _mm_maddubs_epi16(n1, weights));
+		_mm_storeu_si128((__m128i *) (out + i), bytes);
+	}
+
+	return hexDecodeScalar(hex + 2 * i, len - i, out + i);
+}
+
+__attribute__((target("ssse3")))
+static void hexEncodeSsse3(const unsigned char * data, size_t len, char * out){
+	const __m128i digits = _mm_loadu_si128((const __m128i *) hexDigits);
+	const __m128i mask = _mm_set1_epi8(0x0F);
+	size_t i = 0;
+
+	for(; i + 16 <= len; i += 16){
+		const __m128i v = _mm_loadu_si128((const __m128i *) (data + i));
+		const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+		const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, mask));
+		_mm_storeu_si128((__m128i *) (out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i *) (out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+	}
+
+	hexEncodeScalar(data + i, len - i, out + 2 * i);
+}
+
+/* === AVX2 kernels === */
+
+__attribute__((target("avx2")))
+static inline bool nibbles256(__m256i c, __m256i& out){
+	const __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+	const __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+	const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+	const __m256i isAlpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+	out = _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+	                      _mm256_and_si256(isAlpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+	return _mm256_movemask_epi8(_mm256_or_si256(isDigit, isAlpha)) == -1;
+}
+
+__attribute__((target("avx2")))
+static bool hexDecodeAvx2(const char * hex, size_t len, unsigned char * out){
+	const __m256i weights = _mm256_set1_epi16(0x0110);
+	size_t i = 0;
+
+	for(; i + 32 <= len; i += 32){
+		__m256i n0, n1;
+		bool ok = nibbles256(_mm256_loadu_si256((const __m256i *) (hex + 2 * i)), n0);
+		ok &= nibbles256(_mm256_loadu_si256((const __m256i *) (hex + 2 * i + 32)), n1);
+		if(!ok){
+			return false;
+		}
+		/* packus works per 128 bit lane, restore the byte order afterwards */
+		const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(n0, weights),
+		                                           _mm256_maddubs_epi16(n1, weights));
+		_mm256_storeu_si256((__m256i *) (out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+	}
+
+	return hexDecodeSsse3(hex + 2 * i, len - i, out + i);
+}
+
+__attribute__((target("avx2")))
+static void hexEncodeAvx2(const unsigned char * data, size_t len, char * out){
+	const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) hexDigits));
+	const __m256i mask = _mm256_set1_epi8(0x0F);
+	size_t i = 0;
+
+	for(; i + 32 <= len; i += 32){
+		const __m256i v = _mm256_loadu_si256((const __m256i *) (data + i));
+		const __m256i hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+		const __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, mask));
+		/* Unpacking is per lane as well: bytes 0-7 and 16-23 land in a, 8-15 and 24-31 in b */
+		const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+		const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+		_mm256_storeu_si256((__m256i *) (out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+		_mm256_storeu_si256((__m256i *) (out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+	}
+
+	hexEncodeSsse3(data + i, len - i, out + 2 * i);
+}
+
+#endif
+
+/* === Dispatch === */
+
+typedef bool (*hexdecode_t)(const char *, size_t, unsigned char *);
+typedef void (*hexencode_t)(const unsigned char *, size_t, char *);
+
+struct hexkernels_t{
+	hexdecode_t decode;
+	hexencode_t encode;
+	const char * name;
+	bool ssse3;
+	bool avx2;
+
+	hexkernels_t()
+	: decode(hexDecodeScalar), encode(hexEncodeScalar), name("scalar"), ssse3(false), avx2(false)
+	{
+#ifdef HEX_USE_X86
+		__builtin_cpu_init();
+		ssse3 = __builtin_cpu_supports("ssse3");
+		avx2 = ssse3 && __builtin_cpu_supports("avx2");
+#endif
+		select("");
+	}
+
+	/* "" picks the fastest kernel this CPU supports */
+	bool select(const char * wanted){
+		if(*wanted == '\0'){
+			wanted = avx2 ? "avx2" : (ssse3 ? "ssse3" : "scalar");
+		}
+		if(std::strcmp(wanted, "scalar") == 0){
+			decode = hexDecodeScalar;
+			encode = hexEncodeScalar;
+			name = "scalar";
+			return true;
+		}
+#ifdef HEX_USE_X86
+		if(std::strcmp(wanted, "ssse3") == 0 && ssse3){
+			decode = hexDecodeSsse3;
+			encode = hexEncodeSsse3;
+			name = "ssse3";
+			return true;
+		}
+		if(std::strcmp(wanted, "avx2") == 0 && avx2){
+			decode = hexDecodeAvx2;
+			encode = hexEncodeAvx2;
+			name = "avx2";
+			return true;
+		}
+#endif
+		return false;
+	}
+};
+
+static hexkernels_t& kernels(){
+	static hexkernels_t instance;
+	return instance;
+}
+
+const char * HexImplementation(){
+	return kernels().name;
+}
+
+bool SetHexImplementation(const char * name){
+	return kernels().select(name);
+}
+
+bool HexDecode(const char * hex, size_t len, unsigned char * out){
+	return kernels().decode(hex, len, out);
+}
+
+void HexEncode(const unsigned char * data, size_t len, char * out){
+	kernels().encode(data, len, out);
+}
+
+bool HexToBytes(const string& hex, vector<unsigned char>& out){
+	if(hex.size() % 2 != 0){
+		return false;
+	}
+	out.resize(hex.size() / 2);
+	return out.empty() || HexDecode(hex.data(), out.size(), &out[0]);
+}
+
+bool ParseHash(const string& hex, unsigned char hash[32]){
+	unsigned char bytes[32];
+	if(hex.size() != 64 || !HexDecode(hex.data(), 32, bytes)){
+		return false;
+	}
+	for(int i = 0; i < 32; ++i){
+		hash[i] = bytes[31 - i];
+	}
+	return true;
+}
+
+void HexStr(const unsigned char * data, size_t len, string& out, bool reverse){
+	out.resize(2 * len);
+	if(len == 0){
+		return;
+	}
+	if(!reverse){
+		HexEncode(data, len, &out[0]);
+		return;
+	}
+
+	/* Reverse into a small buffer so the vector kernel still does the encoding */
+	unsigned char buffer[64];
+	for(size_t done = 0; done < len; ){
+		size_t chunk = std::min(len - done, sizeof(buffer));
+		for(size_t i = 0; i < chunk; ++i){
+			buffer[i] = data[len - 1 - done - i];
+		}
+		HexEncode(buffer, chunk, &out[2 * done]);
+		done += chunk;
+	}
+}
+
+string HexStr(const unsigned char * data, size_t len, bool reverse){
+	string ret;
+	HexStr(data, len, ret, reverse);
+	return ret;
+}
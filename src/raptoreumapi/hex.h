@@ -0,0 +1,43 @@
+/**
+ * @file    hex.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Conversion between hex strings and binary data, using
+ * SSSE3 or AVX2 where the CPU supports it.
+ */
+
+#ifndef RAPTOREUM_API_HEX_H
+#define RAPTOREUM_API_HEX_H
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+
+// Decodes 2*len hex characters into len bytes, false on a non-hex character
+bool HexDecode(const char * hex, size_t len, unsigned char * out);
+
+// Encodes len bytes as 2*len lowercase hex characters
+void HexEncode(const unsigned char * data, size_t len, char * out);
+
+// False on odd length or non-hex characters
+bool HexToBytes(const std::string& hex, std::vector<unsigned char>& out);
+
+// Hash in display order (64 hex characters) to its 32 internal bytes
+bool ParseHash(const std::string& hex, unsigned char hash[32]);
+
+// reverse: bytes last to first, the order hashes are displayed in
+std::string HexStr(const unsigned char * data, size_t len, bool reverse = false);
+void HexStr(const unsigned char * data, size_t len, std::string& out, bool reverse = false);
+
+// Name of the kernel selected for this CPU: "avx2", "ssse3" or "scalar"
+const char * HexImplementation();
+
+// Switches to the named kernel, "" for the fastest one this CPU supports.
+// False, keeping the current kernel, if the CPU lacks it. Not to be called
+// while other threads convert hex.
+bool SetHexImplementation(const char * name);
+
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file    histogram.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of a latency histogram with constant
+ * relative precision.
+ */
+
+#include "histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+/* Bucket b holds values of 2^(b + 10) to 2^(b + 11) - 1 in steps of 2^b,
+   bucket 0 also the values below 1024 in steps of 1. Only the upper half
+   of each bucket's sub-buckets is stored past bucket 0. */
+size_t Histogram::indexOf(int64_t value) const{
+	int magnitude = 63 - __builtin_clzll((uint64_t) (value | SUB_BUCKET_MASK));
+	int bucket = magnitude - SUB_BUCKET_HALF_COUNT_MAGNITUDE;
+	int64_t subBucket = value >> bucket;
+	return ((size_t) bucket << SUB_BUCKET_HALF_COUNT_MAGNITUDE) + subBucket;
+}
+
+int64_t Histogram::valueAt(size_t index) const{
+	int bucket = (int) (index >> SUB_BUCKET_HALF_COUNT_MAGNITUDE) - 1;
+	int64_t subBucket = (index & (SUB_BUCKET_HALF_COUNT - 1)) + SUB_BUCKET_HALF_COUNT;
+	if(bucket < 0){
+		subBucket -= SUB_BUCKET_HALF_COUNT;
+		bucket = 0;
+	}
+	return subBucket << bucket;
+}
+
+int64_t Histogram::highestEquivalent(size_t index) const{
+	int bucket = std::max((int) (index >> SUB_BUCKET_HALF_COUNT_MAGNITUDE) - 1, 0);
+	return valueAt(index) + (INT64_C(1) << bucket) - 1;
+}
+
+Histogram::Histogram(int64_t highest)
+: highest(highest),
+  total(0),
+  minValue(0),
+  maxValue(0),
+  sum(0)
+{
+	if(highest < 2 * SUB_BUCKET_HALF_COUNT){
+		throw std::invalid_argument("Histogram range too small");
+	}
+	counts.resize(indexOf(highest) + 1);
+}
+
+void Histogram::record(int64_t value, uint64_t count){
+	value = std::min(std::max(value, (int64_t) 0), highest);
+	counts[indexOf(value)] += count;
+
+	if(total == 0 || value < minValue){
+		minValue = value;
+	}
+	if(total == 0 || value > maxValue){
+		maxValue = value;
+	}
+	total += count;
+	sum += (double) value * count;
+}
+
+void Histogram::merge(const Histogram& other){
+	if(other.highest != highest){
+		throw std::invalid_argument("Histogram ranges differ");
+	}
+	if(other.total == 0){
+		return;
+	}
+
+	for(size_t i = 0; i < counts.size(); ++i){
+		counts[i] += other.counts[i];
+	}
+	minValue = (total == 0) ? other.minValue : std::min(minValue, other.minValue);
+	maxValue = (total == 0) ? other.maxValue : std::max(maxValue, other.maxValue);
+	total += other.total;
+	sum += other.sum;
+}
+
+void Histogram::reset(){
+	std::fill(counts.begin(), counts.end(), 0);
+	total = 0;
+	minValue = 0;
+	maxValue = 0;
+	sum = 0;
+}
+
+uint64_t Histogram::count() const{
+	return total;
+}
+
+int64_t Histogram::min() const{
+	return minValue;
+}
+
+int64_t Histogram::max() const{
+	return maxValue;
+}
+
+double Histogram::mean() const{
+	return (total > 0) ? sum / total : 0;
+}
+
+int64_t Histogram::percentile(double percent) const{
+	if(total == 0){
+		return 0;
+	}
+
+	uint64_t wanted = (uint64_t) std::ceil(std::min(std::max(percent, 0.0), 100.0) / 100.0 * total);
+	wanted = std::max<uint64_t>(wanted, 1);
+
+	uint64_t seen = 0;
+	for(size_t i = 0; i < counts.size(); ++i){
+		seen += counts[i];
+		if(seen >= wanted){
+			return std::min(highestEquivalent(i), maxValue);
+		}
+	}
+
+	return maxValue;
+}
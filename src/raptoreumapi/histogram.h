@@ -0,0 +1,62 @@
+/**
+ * @file    histogram.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of a latency histogram with constant relative
+ * precision, laid out like HdrHistogram.
+ */
+
+#ifndef RAPTOREUM_API_HISTOGRAM_H
+#define RAPTOREUM_API_HISTOGRAM_H
+
+#include <cstddef>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Values from 0 to highest are kept with three significant digits: each
+ * power of two range is split into 1024 linear sub-buckets, so recording
+ * is a shift and an increment and percentiles are exact to 0.1%. A
+ * histogram is not thread safe; give each thread its own and merge them.
+ */
+class Histogram
+{
+
+private:
+    static const int SUB_BUCKET_HALF_COUNT_MAGNITUDE = 10;
+    static const int64_t SUB_BUCKET_HALF_COUNT = 1 << SUB_BUCKET_HALF_COUNT_MAGNITUDE;
+    static const int64_t SUB_BUCKET_MASK = 2 * SUB_BUCKET_HALF_COUNT - 1;
+
+    int64_t highest;
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    int64_t minValue;
+    int64_t maxValue;
+    double sum;
+
+    size_t indexOf(int64_t value) const;
+    int64_t valueAt(size_t index) const;
+    int64_t highestEquivalent(size_t index) const;
+
+public:
+    // Values above highest are recorded as highest
+    explicit Histogram(int64_t highest = 3600LL * 1000000);
+
+    void record(int64_t value, uint64_t count = 1);
+    // Both must have the same highest value
+    void merge(const Histogram& other);
+    void reset();
+
+    uint64_t count() const;
+    int64_t min() const;
+    int64_t max() const;
+    double mean() const;
+    // Value that percent of the recorded values are at or below, to the
+    // precision, e.g. percentile(99.9)
+    int64_t percentile(double percent) const;
+};
+
+
+#endif
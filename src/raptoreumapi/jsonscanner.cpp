@@ -0,0 +1,477 @@
+/**
+ * @file    jsonscanner.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of a pull parser that decodes JSON-RPC
+ * responses straight into the result structs.
+ */
+
+#include "jsonscanner.h"
+#include "exception.h"
+
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+using jsonrpc::Errors;
+
+using std::string;
+
+
+JsonScanner::JsonScanner(const string& json)
+: pos(json.c_str()),
+  end(json.c_str() + json.size()),
+  first(false)
+{
+}
+
+void JsonScanner::skipWhitespace(){
+	while(pos < end && (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t')){
+		++pos;
+	}
+}
+
+void JsonScanner::fail(const char * what){
+	throw RaptoreumException(Errors::ERROR_CLIENT_INVALID_RESPONSE,
+	                         string("Invalid response: ") + what);
+}
+
+void JsonScanner::expect(char c){
+	skipWhitespace();
+	if(pos == end || *pos != c){
+		string what = "expected '";
+		what += c;
+		what += "'";
+		fail(what.c_str());
+	}
+	++pos;
+}
+
+/* === Structure === */
+
+bool JsonScanner::beginObject(){
+	if(isNull()){
+		return false;
+	}
+	expect('{');
+	first = true;
+	return true;
+}
+
+bool JsonScanner::beginArray(){
+	if(isNull()){
+		return false;
+	}
+	expect('[');
+	first = true;
+	return true;
+}
+
+/* Nested containers leave first cleared, so after one the outer
+ * container again needs a comma before its next entry */
+bool JsonScanner::nextEntry(char close){
+	skipWhitespace();
+	if(pos < end && *pos == close){
+		++pos;
+		first = false;
+		return false;
+	}
+	if(!first){
+		expect(',');
+		skipWhitespace();
+	}else if(pos < end && *pos == ','){
+		fail("unexpected ','");
+	}
+	if(pos < end && *pos == close){
+		fail("trailing ','");
+	}
+	first = false;
+	return true;
+}
+
+bool JsonScanner::nextMember(string& key){
+	if(!nextEntry('}')){
+		return false;
+	}
+	readString(key);
+	expect(':');
+	return true;
+}
+
+bool JsonScanner::nextElement(){
+	if(!nextEntry(']')){
+		return false;
+	}
+	if(pos == end){
+		fail("unterminated array");
+	}
+	return true;
+}
+
+bool JsonScanner::isNull(){
+	skipWhitespace();
+	if(end - pos >= 4 && std::memcmp(pos, "null", 4) == 0){
+		pos += 4;
+		return true;
+	}
+	return false;
+}
+
+bool JsonScanner::atEnd(){
+	skipWhitespace();
+	return pos == end;
+}
+
+void JsonScanner::skipNumber(){
+	const char * start = pos;
+	while(pos < end && ((*pos >= '0' && *pos <= '9') || *pos == '-' || *pos == '+'
+	                    || *pos == '.' || *pos == 'e' || *pos == 'E')){
+		++pos;
+	}
+	if(pos == start){
+		fail("unexpected character");
+	}
+}
+
+void JsonScanner::skipValue(){
+	skipWhitespace();
+	if(pos == end){
+		fail("unexpected end of input");
+	}
+
+	switch(*pos){
+	case '"':
+		/* Skip without unescaping */
+		for(++pos; pos < end && *pos != '"'; ++pos){
+			if(*pos == '\\'){
+				if(pos + 1 >= end){
+					fail("unterminated string");
+				}
+				++pos;
+			}
+		}
+		expect('"');
+		break;
+	case '{':
+	case '[':{
+		/* Containers are skipped by bracket depth, strings aside */
+		int depth = 0;
+		do{
+			if(*pos == '"'){
+				skipValue();
+				continue;
+			}
+			if(*pos == '{' || *pos == '['){
+				++depth;
+			}else if(*pos == '}' || *pos == ']'){
+				--depth;
+			}
+			++pos;
+		}while(depth > 0 && pos < end);
+
+		if(depth > 0){
+			fail("unterminated container");
+		}
+		break;
+	}
+	case 't':
+	case 'f':
+		readBool();
+		break;
+	case 'n':
+		if(!isNull()){
+			fail("unexpected literal");
+		}
+		break;
+	default:
+		skipNumber();
+	}
+}
+
+/* === Scalars === */
+
+static void appendUtf8(string& out, unsigned long cp){
+	if(cp < 0x80){
+		out += (char) cp;
+	}else if(cp < 0x800){
+		out += (char) (0xC0 | (cp >> 6));
+		out += (char) (0x80 | (cp & 0x3F));
+	}else if(cp < 0x10000){
+		out += (char) (0xE0 | (cp >> 12));
+		out += (char) (0x80 | ((cp >> 6) & 0x3F));
+		out += (char) (0x80 | (cp & 0x3F));
+	}else{
+		out += (char) (0xF0 | (cp >> 18));
+		out += (char) (0x80 | ((cp >> 12) & 0x3F));
+		out += (char) (0x80 | ((cp >> 6) & 0x3F));
+		out += (char) (0x80 | (cp & 0x3F));
+	}
+}
+
+void JsonScanner::readString(string& out){
+	expect('"');
+	out.clear();
+
+	while(true){
+		/* Copy the unescaped run in one go */
+		const char * run = pos;
+		while(pos < end && *pos != '"' && *pos != '\\'){
+			++pos;
+		}
+		out.append(run, pos - run);
+
+		if(pos == end){
+			fail("unterminated string");
+		}
+		if(*pos++ == '"'){
+			return;
+		}
+		if(pos == end){
+			fail("unterminated escape");
+		}
+
+		switch(*pos++){
+		case 'b': out += '\b'; break;
+		case 'f': out += '\f'; break;
+		case 'n': out += '\n'; break;
+		case 'r': out += '\r'; break;
+		case 't': out += '\t'; break;
+		case 'u':{
+			if(end - pos < 4){
+				fail("truncated unicode escape");
+			}
+			char hex[5] = { pos[0], pos[1], pos[2], pos[3], 0 };
+			unsigned long cp = std::strtoul(hex, NULL, 16);
+			pos += 4;
+
+			/* Surrogate pair */
+			if(cp >= 0xD800 && cp < 0xDC00 && end - pos >= 6 && pos[0] == '\\' && pos[1] == 'u'){
+				char low[5] = { pos[2], pos[3], pos[4], pos[5], 0 };
+				unsigned long lo = std::strtoul(low, NULL, 16);
+				if(lo >= 0xDC00 && lo < 0xE000){
+					cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+					pos += 6;
+				}
+			}
+			appendUtf8(out, cp);
+			break;
+		}
+		default:
+			out += pos[-1];
+		}
+	}
+}
+
+string JsonScanner::readString(){
+	string ret;
+	readString(ret);
+	return ret;
+}
+
+/* value * 10 + digit, false if that leaves int64_t */
+static inline bool appendDigit(int64_t& value, int digit){
+	if(value > (std::numeric_limits<int64_t>::max() - digit) / 10){
+		return false;
+	}
+	value = value * 10 + digit;
+	return true;
+}
+
+/* Whether d converts to int64_t without undefined behaviour; false for NaN */
+static inline bool inInt64Range(double d){
+	return d >= -9223372036854775808.0 && d < 9223372036854775808.0;
+}
+
+int64_t JsonScanner::readInt(){
+	skipWhitespace();
+	const char * start = pos;
+	bool negative = (pos < end && *pos == '-');
+	if(negative){
+		++pos;
+	}
+
+	int64_t ret = 0;
+	const char * digits = pos;
+	while(pos < end && *pos >= '0' && *pos <= '9'){
+		if(!appendDigit(ret, *pos++ - '0')){
+			fail("integer out of range");
+		}
+	}
+
+	/* Fractional or exponent forms are rare here, defer to strtod */
+	if(pos < end && (*pos == '.' || *pos == 'e' || *pos == 'E')){
+		pos = start;
+		double d = readDouble();
+		if(!inInt64Range(d)){
+			fail("integer out of range");
+		}
+		return (int64_t) d;
+	}
+	if(pos == digits){
+		fail("expected integer");
+	}
+
+	return negative ? -ret : ret;
+}
+
+double JsonScanner::readDouble(){
+	skipWhitespace();
+	const char * start = pos;
+	while(pos < end && ((*pos >= '0' && *pos <= '9') || *pos == '-' || *pos == '+'
+	                    || *pos == '.' || *pos == 'e' || *pos == 'E')){
+		++pos;
+	}
+	if(pos == start){
+		fail("expected number");
+	}
+
+	/* strtod needs a terminated string and reads the decimal point of the
+	   current locale, so the number is copied out with its point replaced */
+	char buffer[64];
+	string longer;
+	size_t len = pos - start;
+	char * number = buffer;
+	if(len >= sizeof(buffer)){
+		longer.resize(len + 1);
+		number = &longer[0];
+	}
+	const char point = *std::localeconv()->decimal_point;
+	for(size_t i = 0; i < len; ++i){
+		number[i] = (start[i] == '.') ? point : start[i];
+	}
+	number[len] = '\0';
+
+	char * stop = NULL;
+	double ret = std::strtod(number, &stop);
+	if(stop != number + len){
+		pos = start;
+		fail("expected number");
+	}
+	return ret;
+}
+
+bool JsonScanner::readBool(){
+	skipWhitespace();
+	if(end - pos >= 4 && std::memcmp(pos, "true", 4) == 0){
+		pos += 4;
+		return true;
+	}
+	if(end - pos >= 5 && std::memcmp(pos, "false", 5) == 0){
+		pos += 5;
+		return false;
+	}
+	fail("expected boolean");
+	return false;
+}
+
+int64_t JsonScanner::readAmount(){
+	skipWhitespace();
+	const char * start = pos;
+	bool negative = (pos < end && *pos == '-');
+	if(negative){
+		++pos;
+	}
+
+	int64_t ret = 0;
+	bool overflow = false;
+	const char * digits = pos;
+	while(pos < end && *pos >= '0' && *pos <= '9'){
+		overflow |= !appendDigit(ret, *pos++ - '0');
+	}
+	if(pos == digits){
+		fail("expected amount");
+	}
+
+	/* Up to eight decimals are exact, further ones are rounded */
+	int decimals = 0;
+	if(pos < end && *pos == '.'){
+		++pos;
+		for(; pos < end && *pos >= '0' && *pos <= '9'; ++pos){
+			if(decimals < 8){
+				overflow |= !appendDigit(ret, *pos - '0');
+				++decimals;
+			}else if(decimals == 8){
+				if(*pos >= '5' && ret == std::numeric_limits<int64_t>::max()){
+					overflow = true;
+				}else if(*pos >= '5'){
+					++ret;
+				}
+				++decimals;
+			}
+		}
+	}
+	for(; decimals < 8; ++decimals){
+		overflow |= !appendDigit(ret, 0);
+	}
+
+	if(pos < end && (*pos == 'e' || *pos == 'E')){
+		pos = start;
+		double satoshis = readDouble() * 100000000.0;
+		if(!inInt64Range(satoshis)){
+			fail("amount out of range");
+		}
+		return (int64_t) std::llround(satoshis);
+	}
+	if(overflow){
+		fail("amount out of range");
+	}
+
+	return negative ? -ret : ret;
+}
+
+/* === Trees === */
+
+void JsonScanner::readValue(Json::Value& out){
+	skipWhitespace();
+	if(pos == end){
+		fail("unexpected end of input");
+	}
+
+	switch(*pos){
+	case '{':{
+		string key;
+		out = Json::Value(Json::objectValue);
+		beginObject();
+		while(nextMember(key)){
+			readValue(out[key]);
+		}
+		break;
+	}
+	case '[':
+		out = Json::Value(Json::arrayValue);
+		beginArray();
+		while(nextElement()){
+			readValue(out.append(Json::Value()));
+		}
+		break;
+	case '"':
+		out = readString();
+		break;
+	case 't':
+	case 'f':
+		out = readBool();
+		break;
+	case 'n':
+		if(!isNull()){
+			fail("unexpected literal");
+		}
+		out = Json::Value();
+		break;
+	default:{
+		/* Integers stay integers, as with Json::Reader */
+		const char * p = pos;
+		while(p < end && ((*p >= '0' && *p <= '9') || *p == '-')){
+			++p;
+		}
+		if(p < end && (*p == '.' || *p == 'e' || *p == 'E')){
+			out = readDouble();
+		}else{
+			out = (Json::Int64) readInt();
+		}
+	}
+	}
+}
@@ -0,0 +1,80 @@
+/**
+ * @file    jsonscanner.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of a pull parser that decodes JSON-RPC
+ * responses straight into the result structs, without
+ * building an intermediate Json::Value tree.
+ */
+
+#ifndef RAPTOREUM_API_JSONSCANNER_H
+#define RAPTOREUM_API_JSONSCANNER_H
+
+#include <string>
+#include <stdint.h>
+
+namespace Json { class Value; }
+
+/*
+ * Values are read in document order. Objects and arrays are walked as
+ *
+ *   if(scanner.beginObject())
+ *       while(scanner.nextMember(key))
+ *           if(key == "txid") scanner.readString(txid); else scanner.skipValue();
+ *
+ * Every read consumes exactly one value. Malformed input throws a
+ * RaptoreumException with code ERROR_CLIENT_INVALID_RESPONSE.
+ */
+class JsonScanner
+{
+
+private:
+    const char * pos;
+    const char * end;
+    bool first;     // no member or element read yet since the last begin
+
+    void skipWhitespace();
+    void expect(char c);
+    void fail(const char * what);
+    void skipNumber();
+    bool nextEntry(char close);
+
+public:
+    explicit JsonScanner(const std::string& json);
+
+    /* === Structure === */
+
+    // Both return false (and consume it) when the value is null
+    bool beginObject();
+    bool beginArray();
+
+    // Advance to the next member or element, false at the closing bracket
+    bool nextMember(std::string& key);
+    bool nextElement();
+
+    // Consumes the value only if it is null
+    bool isNull();
+    void skipValue();
+    bool atEnd();
+
+    /* === Scalars === */
+
+    void readString(std::string& out);
+    std::string readString();
+    int64_t readInt();
+    double readDouble();
+    bool readBool();
+
+    // Decimal coin amount such as 12.5 read exactly as satoshis
+    int64_t readAmount();
+
+    /* === Trees === */
+
+    // Any value, for results still decoded from a Json::Value
+    void readValue(Json::Value& out);
+};
+
+
+#endif
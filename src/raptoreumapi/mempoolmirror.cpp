@@ -0,0 +1,275 @@
+/**
+ * @file    mempoolmirror.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of a local copy of the daemon's mempool
+ * that is kept up to date incrementally.
+ */
+
+#include "mempoolmirror.h"
+#include "transaction.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using std::string;
+using std::vector;
+
+typedef std::unordered_map<string, mempoolentry_t> entry_map;
+typedef std::unordered_map<string, uint64_t> pending_map;
+
+
+MempoolMirror::MempoolMirror(RaptoreumAPI& rpc, unsigned int batchSize, const chainparams_t& params)
+: rpc(rpc),
+  batchSize(batchSize),
+  params(params),
+  totalSize(0),
+  refreshes(0)
+{
+}
+
+void MempoolMirror::insert(const mempoolentry_t& entry, const decoderawtransaction_t& tx){
+	std::pair<entry_map::iterator, bool> res = entries.insert(std::make_pair(entry.txid, entry));
+	if(!res.second){
+		return;
+	}
+	transactions[entry.txid] = tx;
+
+	/* Map nodes never move, so the indexes can point into them */
+	const mempoolentry_t * ptr = &res.first->second;
+	byFeeRate.insert(feerate_key(ptr->feerate, ptr));
+	bySize.insert(size_key(ptr->size, ptr));
+	totalSize += ptr->size;
+}
+
+void MempoolMirror::erase(entry_map::iterator it){
+	const mempoolentry_t * ptr = &it->second;
+	byFeeRate.erase(feerate_key(ptr->feerate, ptr));
+	bySize.erase(size_key(ptr->size, ptr));
+	totalSize -= ptr->size;
+	transactions.erase(it->first);
+	entries.erase(it);
+}
+
+/* Registers the txids neither mirrored nor being fetched and returns
+   them. Called with the lock held. */
+vector<string> MempoolMirror::claim(const vector<string>& txids){
+	vector<string> ret;
+	for(size_t i = 0; i < txids.size(); ++i){
+		if(entries.count(txids[i]) == 0 && pending.insert(std::make_pair(txids[i], refreshes)).second){
+			ret.push_back(txids[i]);
+		}
+	}
+	return ret;
+}
+
+/* txs holds the decoded transactions when the caller has them, in the
+   order of txids, else they are fetched along with the entries. Returns
+   the number of entries inserted. */
+size_t MempoolMirror::fetch(const vector<string>& txids, uint64_t claimed, vector<decoderawtransaction_t> txs){
+	if(txids.empty()){
+		return 0;
+	}
+
+	/* Network round trips happen outside the lock */
+	vector<mempoolentry_t> fetched;
+	vector<bool> decoded(txids.size(), !txs.empty());
+	try{
+		fetched = rpc.getMempoolEntries(txids, batchSize);
+		if(txs.empty()){
+			vector<Result<getrawtransaction_t> > raw = rpc.tryGetRawTransactions(txids, 0, batchSize);
+			txs.resize(txids.size());
+			for(size_t i = 0; i < raw.size(); ++i){
+				if(!raw[i]){
+					continue;
+				}
+				/* A transaction the decoder rejects is skipped, not the
+				   whole fetch, and tried again on the next refresh */
+				try{
+					getrawtransaction_t tx;
+					DecodeRawTransaction(raw[i].value().hex, tx, params);
+					txs[i] = tx;
+					decoded[i] = true;
+				}
+				catch(RaptoreumException& e){
+				}
+			}
+		}
+	}
+	catch(...){
+		std::lock_guard<std::mutex> guard(lock);
+		for(size_t i = 0; i < txids.size(); ++i){
+			pending_map::iterator it = pending.find(txids[i]);
+			if(it != pending.end() && it->second == claimed){
+				pending.erase(it);
+			}
+		}
+		throw;
+	}
+
+	std::lock_guard<std::mutex> guard(lock);
+
+	/* Entries are returned in order, without the txids that left */
+	size_t next = 0;
+	size_t inserted = 0;
+	for(size_t i = 0; i < txids.size(); ++i){
+		pending_map::iterator it = pending.find(txids[i]);
+		if(it == pending.end() || it->second != claimed){
+			/* Dropped by a refresh meanwhile */
+			continue;
+		}
+		pending.erase(it);
+
+		while(next < fetched.size() && fetched[next].txid != txids[i]){
+			++next;
+		}
+		if(next < fetched.size() && decoded[i]){
+			insert(fetched[next], txs[i]);
+			++inserted;
+		}
+	}
+
+	return inserted;
+}
+
+size_t MempoolMirror::refresh(){
+	uint64_t started;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		started = ++refreshes;
+	}
+
+	vector<string> snapshot = rpc.getRawMempool();
+	std::unordered_set<string> current(snapshot.begin(), snapshot.end());
+	vector<string> added;
+	uint64_t claimed;
+	size_t removed = 0;
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		for(entry_map::iterator it = entries.begin(); it != entries.end(); ){
+			if(current.count(it->first) == 0){
+				erase(it++);
+				++removed;
+			}else{
+				++it;
+			}
+		}
+
+		/* Fetches claimed before the snapshot was taken are stale if it
+		   no longer has their txids */
+		for(pending_map::iterator it = pending.begin(); it != pending.end(); ){
+			if(it->second < started && current.count(it->first) == 0){
+				pending.erase(it++);
+			}else{
+				++it;
+			}
+		}
+
+		added = claim(snapshot);
+		claimed = refreshes;
+	}
+
+	return removed + fetch(added, claimed);
+}
+
+void MempoolMirror::add(const vector<string>& txids){
+	vector<string> missing;
+	uint64_t claimed;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		missing = claim(txids);
+		claimed = refreshes;
+	}
+
+	fetch(missing, claimed);
+}
+
+void MempoolMirror::add(const decoderawtransaction_t& tx){
+	vector<string> missing;
+	uint64_t claimed;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		missing = claim(vector<string>(1, tx.txid));
+		claimed = refreshes;
+	}
+
+	if(!missing.empty()){
+		fetch(missing, claimed, vector<decoderawtransaction_t>(1, tx));
+	}
+}
+
+/* === Queries === */
+
+size_t MempoolMirror::size() const{
+	std::lock_guard<std::mutex> guard(lock);
+	return entries.size();
+}
+
+uint64_t MempoolMirror::bytes() const{
+	std::lock_guard<std::mutex> guard(lock);
+	return totalSize;
+}
+
+bool MempoolMirror::find(const string& txid, mempoolentry_t& entry) const{
+	std::lock_guard<std::mutex> guard(lock);
+	entry_map::const_iterator it = entries.find(txid);
+	if(it == entries.end()){
+		return false;
+	}
+	entry = it->second;
+	return true;
+}
+
+bool MempoolMirror::find(const string& txid, decoderawtransaction_t& tx) const{
+	std::lock_guard<std::mutex> guard(lock);
+	std::unordered_map<string, decoderawtransaction_t>::const_iterator it = transactions.find(txid);
+	if(it == transactions.end()){
+		return false;
+	}
+	tx = it->second;
+	return true;
+}
+
+vector<mempoolentry_t> MempoolMirror::getByFeeRate(size_t count) const{
+	std::lock_guard<std::mutex> guard(lock);
+	vector<mempoolentry_t> ret;
+	ret.reserve(std::min(count, byFeeRate.size()));
+
+	for(std::set<feerate_key>::const_reverse_iterator it = byFeeRate.rbegin();
+	    it != byFeeRate.rend() && ret.size() < count; it++){
+		ret.push_back(*it->second);
+	}
+
+	return ret;
+}
+
+vector<mempoolentry_t> MempoolMirror::getBySize(size_t count) const{
+	std::lock_guard<std::mutex> guard(lock);
+	vector<mempoolentry_t> ret;
+	ret.reserve(std::min(count, bySize.size()));
+
+	for(std::set<size_key>::const_reverse_iterator it = bySize.rbegin();
+	    it != bySize.rend() && ret.size() < count; it++){
+		ret.push_back(*it->second);
+	}
+
+	return ret;
+}
+
+int64_t MempoolMirror::getFeeRateForBytes(uint64_t maxBytes) const{
+	std::lock_guard<std::mutex> guard(lock);
+	uint64_t used = 0;
+
+	for(std::set<feerate_key>::const_reverse_iterator it = byFeeRate.rbegin(); it != byFeeRate.rend(); it++){
+		used += it->second->size;
+		if(used > maxBytes){
+			return it->first;
+		}
+	}
+
+	return 0;
+}
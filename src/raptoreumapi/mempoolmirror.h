@@ -0,0 +1,87 @@
+/**
+ * @file    mempoolmirror.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of a local copy of the daemon's mempool that
+ * is kept up to date incrementally, with fee rate and size
+ * indexes for fee estimation and monitoring. The decoded
+ * transactions are kept along with the entries.
+ */
+
+#ifndef RAPTOREUM_API_MEMPOOLMIRROR_H
+#define RAPTOREUM_API_MEMPOOLMIRROR_H
+
+#include "raptoreumapi.h"
+
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+class MempoolMirror
+{
+
+private:
+    typedef std::pair<int64_t, const mempoolentry_t *> feerate_key;
+    typedef std::pair<unsigned int, const mempoolentry_t *> size_key;
+
+    RaptoreumAPI& rpc;
+    unsigned int batchSize;
+    chainparams_t params;
+
+    mutable std::mutex lock;
+    std::unordered_map<std::string, mempoolentry_t> entries;
+    std::unordered_map<std::string, decoderawtransaction_t> transactions;
+    std::set<feerate_key> byFeeRate;
+    std::set<size_key> bySize;
+    uint64_t totalSize;
+
+    // Txids being fetched, with the number of refreshes started before.
+    // A refresh that no longer finds them drops them, so a fetch that
+    // completes afterwards does not bring them back.
+    std::unordered_map<std::string, uint64_t> pending;
+    uint64_t refreshes;
+
+    void insert(const mempoolentry_t& entry, const decoderawtransaction_t& tx);
+    void erase(std::unordered_map<std::string, mempoolentry_t>::iterator it);
+    std::vector<std::string> claim(const std::vector<std::string>& txids);
+    size_t fetch(const std::vector<std::string>& txids, uint64_t claimed,
+               std::vector<decoderawtransaction_t> txs = std::vector<decoderawtransaction_t>());
+
+public:
+    MempoolMirror(RaptoreumAPI& rpc, unsigned int batchSize = 500,
+                  const chainparams_t& params = MainNetParams());
+
+    // Diffs getrawmempool against the mirror: drops entries that left and
+    // fetches only the new txids, in batches. Returns the entries removed
+    // plus those inserted; new txids that left meanwhile or that do not
+    // decode are not counted and are tried again on the next refresh.
+    size_t refresh();
+
+    // Fetches txids announced ahead of the next refresh, e.g. from a
+    // hashtx notification. Known txids are ignored.
+    void add(const std::vector<std::string>& txids);
+    // Same for a transaction already decoded, e.g. from a rawtx
+    // notification, only its mempool entry is fetched
+    void add(const decoderawtransaction_t& tx);
+
+    /* === Queries === */
+
+    size_t size() const;
+    uint64_t bytes() const;
+    bool find(const std::string& txid, mempoolentry_t& entry) const;
+    bool find(const std::string& txid, decoderawtransaction_t& tx) const;
+
+    // Entries with the highest fee rate (or largest size) first
+    std::vector<mempoolentry_t> getByFeeRate(size_t count) const;
+    std::vector<mempoolentry_t> getBySize(size_t count) const;
+
+    // Lowest fee rate within the best paying maxBytes of the mempool,
+    // i.e. what it takes to make it into a block of that size. 0 if
+    // the whole mempool fits.
+    int64_t getFeeRateForBytes(uint64_t maxBytes) const;
+};
+
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * @file    payoutplanner.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of a planner that packs large payout lists
+ * into few size bounded transactions.
+ */
+
+#include "payoutplanner.h"
+#include "exception.h"
+#include "txbuilder.h"
+
+#include <algorithm>
+
+using std::string;
+using std::vector;
+
+/* Version, locktime and both counts at their three byte width */
+static const size_t TX_OVERHEAD = 4 + 4 + 3 + 3;
+
+/* Value, length and script of a P2PKH (or smaller P2SH) output */
+static const size_t OUTPUT_SIZE = 8 + 1 + 25;
+
+
+PayoutPlanner::PayoutPlanner(const string& changeAddress, int64_t feeRate, const chainparams_t& params)
+: changeAddress(changeAddress),
+  feeRate(feeRate),
+  params(params),
+  maxSize(MAX_STANDARD_SIZE),
+  maxOutputs(0),
+  dustThreshold(546)
+{
+	vector<unsigned char> script;
+	if(!AddressToScript(changeAddress, script, params)){
+		throw RaptoreumException(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address " + changeAddress);
+	}
+}
+
+PayoutPlanner& PayoutPlanner::setMaxSize(size_t bytes){
+	maxSize = bytes;
+	return *this;
+}
+
+PayoutPlanner& PayoutPlanner::setMaxOutputs(size_t outputs){
+	maxOutputs = outputs;
+	return *this;
+}
+
+PayoutPlanner& PayoutPlanner::setDustThreshold(int64_t satoshis){
+	dustThreshold = satoshis;
+	return *this;
+}
+
+int64_t PayoutPlanner::feeFor(size_t size) const{
+	return (feeRate * (int64_t) size + 999) / 1000;
+}
+
+static bool bySatoshisDescending(const addressutxo_t * a, const addressutxo_t * b){
+	return a->satoshis > b->satoshis;
+}
+
+payoutplan_t PayoutPlanner::plan(const vector<payout_t>& payouts, const vector<addressutxo_t>& utxos) const{
+	payoutplan_t ret;
+	ret.fee = 0;
+
+	vector<const addressutxo_t *> pool(utxos.size());
+	for(size_t i = 0; i < utxos.size(); ++i){
+		pool[i] = &utxos[i];
+	}
+	std::sort(pool.begin(), pool.end(), bySatoshisDescending);
+
+	size_t nextPayout = 0;
+	size_t nextUtxo = 0;
+	bool funded = true;
+	vector<unsigned char> script;
+
+	while(nextPayout < payouts.size() && funded){
+		plannedtx_t tx;
+		size_t inputs = 0;
+		int64_t inSum = 0, outSum = 0;
+		/* The change output is always counted, it is rarely left out */
+		size_t size = TX_OVERHEAD + OUTPUT_SIZE;
+
+		for(; nextPayout < payouts.size(); ++nextPayout){
+			const payout_t& payout = payouts[nextPayout];
+			if(payout.satoshis < dustThreshold || !AddressToScript(payout.address, script, params)){
+				ret.unplanned.push_back(nextPayout);
+				continue;
+			}
+			if(maxOutputs != 0 && tx.payouts.size() >= maxOutputs){
+				break;
+			}
+
+			/* Tentatively add the payout and the inputs it needs */
+			size_t trySize = size + 8 + 1 + script.size();
+			int64_t tryOut = outSum + payout.satoshis;
+			int64_t tryIn = inSum;
+			size_t tryInputs = inputs;
+			while(tryIn < tryOut + feeFor(trySize) && nextUtxo + tryInputs < pool.size()){
+				tryIn += pool[nextUtxo + tryInputs]->satoshis;
+				trySize += TransactionBuilder::P2PKH_INPUT_SIZE;
+				++tryInputs;
+			}
+
+			if(tryIn < tryOut + feeFor(trySize)){
+				funded = false;
+				break;
+			}
+			if(trySize > maxSize){
+				if(tx.payouts.empty()){
+					ret.unplanned.push_back(nextPayout);
+					continue;
+				}
+				break;
+			}
+
+			size = trySize;
+			outSum = tryOut;
+			inSum = tryIn;
+			inputs = tryInputs;
+			tx.payouts.push_back(nextPayout);
+		}
+
+		if(tx.payouts.empty()){
+			break;
+		}
+
+		TransactionBuilder builder(params);
+		for(size_t i = 0; i < inputs; ++i){
+			const addressutxo_t& utxo = *pool[nextUtxo + i];
+			builder.addInput(utxo.txid, utxo.outputIndex);
+			tx.inputs.push_back(utxo);
+		}
+		nextUtxo += inputs;
+
+		for(size_t i = 0; i < tx.payouts.size(); ++i){
+			const payout_t& payout = payouts[tx.payouts[i]];
+			builder.addOutput(payout.address, payout.satoshis);
+		}
+
+		tx.change = inSum - outSum - feeFor(size);
+		if(tx.change >= dustThreshold){
+			builder.addOutput(changeAddress, tx.change);
+		}else{
+			tx.change = 0;
+		}
+
+		tx.fee = inSum - outSum - tx.change;
+		tx.size = builder.signedSize();
+		tx.hex = builder.toHex();
+		ret.fee += tx.fee;
+		ret.transactions.push_back(tx);
+	}
+
+	/* Whatever the UTXOs could not fund */
+	for(; nextPayout < payouts.size(); ++nextPayout){
+		ret.unplanned.push_back(nextPayout);
+	}
+
+	return ret;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file    payoutplanner.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of a planner that packs large payout lists
+ * into few size bounded transactions, built offline and
+ * ready to be signed and broadcast in one batch.
+ */
+
+#ifndef RAPTOREUM_API_PAYOUTPLANNER_H
+#define RAPTOREUM_API_PAYOUTPLANNER_H
+
+#include "types.h"
+#include "script.h"
+
+#include <stdint.h>
+
+struct payout_t{
+	std::string address;
+	int64_t satoshis;
+};
+
+struct plannedtx_t{
+	std::string hex;                    // unsigned, for signrawtransaction
+	std::vector<addressutxo_t> inputs;
+	std::vector<size_t> payouts;        // indexes into the planned payouts
+	int64_t fee;
+	int64_t change;                     // 0 if it was too small and left as fee
+	size_t size;                        // estimated signed size
+};
+
+struct payoutplan_t{
+	std::vector<plannedtx_t> transactions;
+	std::vector<size_t> unplanned;      // invalid, dust or unfunded payouts
+	int64_t fee;
+};
+
+/*
+ * Payouts are taken in order and added to a transaction as long as it
+ * stays under the size limit; the largest UTXOs are spent first so few
+ * inputs are needed. Every transaction returns its change to the change
+ * address and spends disjoint inputs, so they can be broadcast together
+ * with RaptoreumAPI::sendRawTransactions once signed.
+ */
+class PayoutPlanner
+{
+
+private:
+    std::string changeAddress;
+    int64_t feeRate;
+    chainparams_t params;
+    size_t maxSize;
+    size_t maxOutputs;
+    int64_t dustThreshold;
+
+    int64_t feeFor(size_t size) const;
+
+public:
+    // Standard transaction size limit of the daemon
+    static const size_t MAX_STANDARD_SIZE = 100000;
+
+    /* feeRate: satoshis per 1000 bytes of signed transaction. An invalid
+       changeAddress throws a RaptoreumException with RPC_INVALID_ADDRESS_OR_KEY */
+    PayoutPlanner(const std::string& changeAddress, int64_t feeRate,
+                  const chainparams_t& params = MainNetParams());
+
+    PayoutPlanner& setMaxSize(size_t bytes);
+    // 0 for no limit other than the size
+    PayoutPlanner& setMaxOutputs(size_t outputs);
+    // Payouts and change below this are not created
+    PayoutPlanner& setDustThreshold(int64_t satoshis);
+
+    payoutplan_t plan(const std::vector<payout_t>& payouts, const std::vector<addressutxo_t>& utxos) const;
+};
+
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * @file    probes.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * USDT probes on the RPC path for bpftrace and perf. They
+ * compile to a nop when built with HAVE_USDT and to nothing
+ * otherwise. The provider is raptoreumapi:
+ *
+ *   request__start(method)
+ *   parse__start(method, response bytes)
+ *   decode__start(method)
+ *   decode__end(method)
+ *   parse__end(method, response bytes)
+ *   request__end(method, calls, request bytes, response bytes, code)
+ *   error(method, code)
+ *
+ * e.g. bpftrace -e 'usdt:./libraptoreumapi.so:raptoreumapi:error
+ *                   { @[str(arg0), arg1] = count(); }'
+ */
+
+#ifndef RAPTOREUM_API_PROBES_H
+#define RAPTOREUM_API_PROBES_H
+
+#ifdef HAVE_USDT
+#include <sys/sdt.h>
+
+#define RAPTOREUMAPI_PROBE1(name, a) DTRACE_PROBE1(raptoreumapi, name, a)
+#define RAPTOREUMAPI_PROBE2(name, a, b) DTRACE_PROBE2(raptoreumapi, name, a, b)
+#define RAPTOREUMAPI_PROBE5(name, a, b, c, d, e) DTRACE_PROBE5(raptoreumapi, name, a, b, c, d, e)
+#else
+#define RAPTOREUMAPI_PROBE1(name, a)
+#define RAPTOREUMAPI_PROBE2(name, a, b)
+#define RAPTOREUMAPI_PROBE5(name, a, b, c, d, e)
+#endif
+
+#endif
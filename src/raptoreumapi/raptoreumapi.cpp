@@ -9,14 +9,27 @@
  */
 
 #include "raptoreumapi.h"
+#include "transaction.h"
+#include "block.h"
+#include "rpcmetrics.h"
+#include "rpctrace.h"
+#include "probes.h"
 
 #include <string>
 #include <stdexcept>
 #include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 #include <jsonrpccpp/client.h>
 #include <jsonrpccpp/client/connectors/httpclient.h>
 
+using jsonrpc::BatchCall;
+using jsonrpc::BatchResponse;
 using jsonrpc::Client;
 using jsonrpc::JSONRPC_CLIENT_V1;
 
@@ -30,9 +43,156 @@ using std::map;
 using std::string;
 using std::vector;
 
+typedef std::chrono::steady_clock Clock;
+
+
+/* https unless host names its scheme */
+static string rpcUrl(const string& user, const string& password, const string& host, const string& port){
+	size_t scheme = host.find("://");
+	if(scheme == string::npos){
+		return "https://" + user + ":" + password + "@" + host + ":" + port;
+	}
+	return host.substr(0, scheme + 3) + user + ":" + password + "@" + host.substr(scheme + 3) + ":" + port;
+}
+
+/* === Metrics and tracing === */
+
+/* The round trip in progress on this thread. The phase times are only
+   taken when tracer is set. */
+struct calltrace_t{
+	const char * method;
+	RpcTracer * tracer;
+	size_t sentBytes;
+	size_t receivedBytes;
+	Clock::time_point sendStart;
+	Clock::time_point sendEnd;
+	Clock::duration decode;
+	string request;
+	string response;
+};
+
+static thread_local calltrace_t current = calltrace_t();
+
+/* HttpClient that notes the sizes and times of what it sends and receives */
+class MeteredHttpClient : public HttpClient
+{
+public:
+	explicit MeteredHttpClient(const string& url) : HttpClient(url) { }
+
+	void SendRPCMessage(const string& message, string& result){
+		current.sentBytes = message.size();
+		if(current.tracer != NULL){
+			current.request.assign(message, 0, RpcTracer::CAPTURE_BYTES);
+			current.sendStart = Clock::now();
+		}
+		try{
+			HttpClient::SendRPCMessage(message, result);
+		}
+		catch (JsonRpcException& e){
+			if(current.tracer != NULL){
+				current.sendEnd = Clock::now();
+				current.response.assign(e.GetMessage(), 0, RpcTracer::CAPTURE_BYTES);
+			}
+			throw;
+		}
+		if(current.tracer != NULL){
+			current.sendEnd = Clock::now();
+			current.response.assign(result, 0, RpcTracer::CAPTURE_BYTES);
+		}
+		current.receivedBytes = result.size();
+		RAPTOREUMAPI_PROBE2(parse__start, current.method, current.receivedBytes);
+	}
+};
+
+static Clock::time_point startcall(const string& command){
+	RAPTOREUMAPI_PROBE1(request__start, command.c_str());
+	Clock::time_point start = Clock::now();
+	current.method = command.c_str();
+	current.tracer = RpcTracer::installed();
+	current.sentBytes = 0;
+	current.receivedBytes = 0;
+	current.sendStart = current.sendEnd = start;
+	current.decode = Clock::duration::zero();
+	if(current.tracer != NULL){
+		current.request.clear();
+		current.response.clear();
+	}
+	return start;
+}
+
+/* Runs decode, timing it when tracing */
+static void timedecode(const std::function<void(JsonScanner&)>& decode, JsonScanner& scanner){
+	if(current.tracer == NULL){
+		RAPTOREUMAPI_PROBE1(decode__start, current.method);
+		decode(scanner);
+		RAPTOREUMAPI_PROBE1(decode__end, current.method);
+		return;
+	}
+	Clock::time_point start = Clock::now();
+	RAPTOREUMAPI_PROBE1(decode__start, current.method);
+	try{
+		decode(scanner);
+	}
+	catch (...){
+		current.decode += Clock::now() - start;
+		throw;
+	}
+	RAPTOREUMAPI_PROBE1(decode__end, current.method);
+	current.decode += Clock::now() - start;
+}
+
+/* Records a round trip of calls calls of command begun at start, failed
+   for all of them with code unless 0 */
+static void endcall(const string& command, unsigned int calls, Clock::time_point start, int code = 0){
+	Clock::time_point end = Clock::now();
+	int64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	RAPTOREUMAPI_PROBE2(parse__end, command.c_str(), current.receivedBytes);
+	if(code != 0){
+		RAPTOREUMAPI_PROBE2(error, command.c_str(), code);
+	}
+	RAPTOREUMAPI_PROBE5(request__end, command.c_str(), calls, current.sentBytes, current.receivedBytes, code);
+
+	RpcMetrics::record(command, calls, latency, current.sentBytes, current.receivedBytes);
+	if(code != 0){
+		RpcMetrics::recordError(command, code, calls);
+	}
+
+	if(current.tracer != NULL){
+		using std::chrono::nanoseconds;
+		using std::chrono::duration_cast;
+
+		rpcspan_t span;
+		span.method = command;
+		span.calls = calls;
+		span.code = code;
+		span.requestBytes = current.sentBytes;
+		span.responseBytes = current.receivedBytes;
+		span.request = current.request;
+		span.response = current.response;
+		span.start = start;
+		span.serialize = duration_cast<nanoseconds>(current.sendStart - start).count();
+		span.transport = duration_cast<nanoseconds>(current.sendEnd - current.sendStart).count();
+		span.decode = duration_cast<nanoseconds>(current.decode).count();
+		span.parse = duration_cast<nanoseconds>(end - current.sendEnd).count() - span.decode;
+		span.total = duration_cast<nanoseconds>(end - start).count();
+		current.tracer->onSpan(span);
+	}
+}
 
 RaptoreumAPI::RaptoreumAPI(const string& user, const string& password, const string& host, int port, int httpTimeout)
-: httpClient(new HttpClient("https://" + user + ":" + password + "@" + host + ":" + IntegerToString(port))),
+: url(rpcUrl(user, password, host, IntegerToString(port))),
+  httpTimeout(httpTimeout),
+  httpClient(new MeteredHttpClient(url)),
+  client(new Client(*httpClient, JSONRPC_CLIENT_V1))
+{
+    httpClient->SetTimeout(httpTimeout);
+}
+
+RaptoreumAPI::RaptoreumAPI(const RaptoreumAPI& other)
+: url(other.url),
+  httpTimeout(other.httpTimeout),
+  httpClient(new MeteredHttpClient(url)),
   client(new Client(*httpClient, JSONRPC_CLIENT_V1))
 {
     httpClient->SetTimeout(httpTimeout);
@@ -46,18 +206,332 @@ RaptoreumAPI::~RaptoreumAPI()
 
 Value RaptoreumAPI::sendcommand(const string& command, const Value& params){    
     Value result;
+	Clock::time_point start = startcall(command);
 
     try{
 		result = client->CallMethod(command, params);
 	}
 	catch (JsonRpcException& e){
 		RaptoreumException err(e.GetCode(), e.GetMessage());
+		endcall(command, 1, start, err.getCode());
+		throw err;
+	}
+
+	endcall(command, 1, start);
+	return result;
+}
+
+void RaptoreumAPI::sendcommand(const string& command, const Value& params,
+                               const std::function<void(JsonScanner&)>& decode){
+	Clock::time_point start = startcall(command);
+	Value request;
+	request["jsonrpc"] = "1.0";
+	request["id"] = 1;
+	request["method"] = command;
+	request["params"] = params.isNull() ? Value(Json::arrayValue) : params;
+
+	Json::FastWriter writer;
+	string response;
+
+	try{
+		httpClient->SendRPCMessage(writer.write(request), response);
+	}
+	catch (JsonRpcException& e){
+		RaptoreumException err(e.GetCode(), e.GetMessage());
+		endcall(command, 1, start, err.getCode());
 		throw err;
 	}
 
+	try{
+		JsonScanner scanner(response);
+		string key;
+
+		if(!scanner.beginObject()){
+			throw RaptoreumException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid response: null");
+		}
+
+		while(scanner.nextMember(key)){
+			if(key == "result" && !scanner.isNull()){
+				timedecode(decode, scanner);
+			}else if(key == "error" && !scanner.isNull()){
+				throw RaptoreumException::fromErrorObject(scanner);
+			}else if(key != "result" && key != "error"){
+				scanner.skipValue();
+			}
+		}
+	}
+	catch (RaptoreumException& e){
+		endcall(command, 1, start, e.getCode());
+		throw;
+	}
+
+	endcall(command, 1, start);
+}
+
+/* Sends params[first, last) as one batch and stores the results in place.
+   Call errors throw, unless errors is given to collect their codes. */
+static void sendbatchrange(Client& rpc, const string& command, const vector<Value>& params,
+                           size_t first, size_t last, vector<Value>& results, vector<int>* errors){
+	Clock::time_point start = startcall(command);
+	BatchCall batch;
+	vector<int> ids;
+	ids.reserve(last - first);
+
+	for(size_t i = first; i < last; ++i){
+		ids.push_back(batch.addCall(command, params[i]));
+	}
+
+	BatchResponse response;
+	try{
+		rpc.CallProcedures(batch, response);
+	}
+	catch (JsonRpcException& e){
+		RaptoreumException err(e.GetCode(), e.GetMessage());
+		endcall(command, last - first, start, err.getCode());
+		throw err;
+	}
+	endcall(command, last - first, start);
+
+	Value error;
+	for(size_t i = first; i < last; ++i){
+		Value id(ids[i - first]);
+		int code = response.getErrorCode(id);
+		if(code != 0){
+			RAPTOREUMAPI_PROBE2(error, command.c_str(), code);
+			RpcMetrics::recordError(command, code);
+			if(errors != NULL){
+				(*errors)[i] = code;
+			}else if(error.isNull()){
+				response.getResult(id, error);
+			}
+			continue;
+		}
+		response.getResult(id, results[i]);
+	}
+
+	if(!error.isNull()){
+		throw RaptoreumException(error);
+	}
+}
+
+/* Same for scanbatch: each result is decoded by decode while it is scanned,
+   each failed call leaves its error in errors. The daemon answers a batch
+   in request order, which is checked against the ids. */
+static void scanbatchrange(HttpClient& http, const string& command, const vector<Value>& params,
+                           size_t first, size_t last, const std::function<void(size_t, JsonScanner&)>& decode,
+                           vector<RpcError>& errors){
+	Clock::time_point start = startcall(command);
+	Value batch(Json::arrayValue);
+
+	for(size_t i = first; i < last; ++i){
+		Value request;
+		request["jsonrpc"] = "1.0";
+		request["id"] = (Json::UInt64) i;
+		request["method"] = command;
+		request["params"] = params[i].isNull() ? Value(Json::arrayValue) : params[i];
+		batch.append(request);
+	}
+
+	Json::FastWriter writer;
+	string response;
+
+	try{
+		http.SendRPCMessage(writer.write(batch), response);
+	}
+	catch (JsonRpcException& e){
+		RaptoreumException err(e.GetCode(), e.GetMessage());
+		endcall(command, last - first, start, err.getCode());
+		throw err;
+	}
+
+	try{
+		JsonScanner scanner(response);
+		string key;
+		size_t i = first;
+
+		if(!scanner.beginArray()){
+			throw RaptoreumException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid response: null");
+		}
+		while(scanner.nextElement()){
+			int64_t id = -1;
+			if(i == last || !scanner.beginObject()){
+				throw RaptoreumException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid response: batch mismatch");
+			}
+			while(scanner.nextMember(key)){
+				if(key == "result" && !scanner.isNull()){
+					timedecode([&decode, i](JsonScanner& s){ decode(i, s); }, scanner);
+				}else if(key == "error" && !scanner.isNull()){
+					errors[i] = RpcError(RaptoreumException::fromErrorObject(scanner));
+					RAPTOREUMAPI_PROBE2(error, command.c_str(), errors[i].getCode());
+					RpcMetrics::recordError(command, errors[i].getCode());
+				}else if(key == "id"){
+					id = scanner.readInt();
+				}else if(key != "result" && key != "error"){
+					scanner.skipValue();
+				}
+			}
+			if(id != (int64_t) i++){
+				throw RaptoreumException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid response: batch out of order");
+			}
+		}
+		if(i != last){
+			throw RaptoreumException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid response: batch mismatch");
+		}
+	}
+	catch (RaptoreumException& e){
+		endcall(command, last - first, start, e.getCode());
+		throw;
+	}
+
+	endcall(command, last - first, start);
+}
+
+/* Runs send for batches batch numbers, over http alone when there are
+   few, else over up to threads connections of their own. The first
+   exception stops the remaining batches and is rethrown. */
+static void runbatches(HttpClient& http, const string& url, int httpTimeout, size_t batches, unsigned int threads,
+                       const std::function<void(HttpClient&, size_t)>& send){
+	/* Small requests go over the existing connection */
+	if(batches <= 1 || threads <= 1){
+		for(size_t b = 0; b < batches; ++b){
+			send(http, b);
+		}
+		return;
+	}
+
+	/* Larger ones are spread over worker threads, one connection each */
+	std::atomic<size_t> next(0);
+	std::exception_ptr error;
+	std::mutex errorMutex;
+	vector<std::thread> workers;
+
+	for(size_t t = 0; t < std::min<size_t>(threads, batches); ++t){
+		workers.push_back(std::thread([&](){
+			MeteredHttpClient worker(url);
+			worker.SetTimeout(httpTimeout);
+
+			for(size_t b = next++; b < batches; b = next++){
+				try{
+					send(worker, b);
+				}
+				catch(...){
+					std::lock_guard<std::mutex> lock(errorMutex);
+					if(!error){
+						error = std::current_exception();
+					}
+					next = batches;
+				}
+			}
+		}));
+	}
+
+	for(size_t t = 0; t < workers.size(); ++t){
+		workers[t].join();
+	}
+
+	if(error){
+		std::rethrow_exception(error);
+	}
+}
+
+vector<Value> RaptoreumAPI::sendbatch(const string& command, const vector<Value>& params,
+                                      unsigned int batchSize, unsigned int threads){
+	return batchcommand(command, params, NULL, batchSize, threads);
+}
+
+vector<Value> RaptoreumAPI::sendbatch(const string& command, const vector<Value>& params, vector<int>& errors,
+                                      unsigned int batchSize, unsigned int threads){
+	errors.assign(params.size(), 0);
+	return batchcommand(command, params, &errors, batchSize, threads);
+}
+
+vector<Value> RaptoreumAPI::batchcommand(const string& command, const vector<Value>& params, vector<int>* errors,
+                                         unsigned int batchSize, unsigned int threads){
+	vector<Value> results(params.size());
+	size_t size = std::max(batchSize, 1u);
+	size_t batches = (params.size() + size - 1) / size;
+
+	runbatches(*httpClient, url, httpTimeout, batches, threads, [&](HttpClient& http, size_t b){
+		Client rpc(http, JSONRPC_CLIENT_V1);
+		sendbatchrange(rpc, command, params, b * size, std::min(params.size(), (b + 1) * size), results, errors);
+	});
+
+	return results;
+}
+
+void RaptoreumAPI::scanbatch(const string& command, const vector<Value>& params,
+                             const std::function<void(size_t, JsonScanner&)>& decode, vector<RpcError>& errors,
+                             unsigned int batchSize, unsigned int threads){
+	size_t size = std::max(batchSize, 1u);
+	size_t batches = (params.size() + size - 1) / size;
+	errors.assign(params.size(), RpcError());
+
+	runbatches(*httpClient, url, httpTimeout, batches, threads, [&](HttpClient& http, size_t b){
+		scanbatchrange(http, command, params, b * size, std::min(params.size(), (b + 1) * size), decode, errors);
+	});
+}
+
+Result<Value> RaptoreumAPI::trycommand(const string& command, const Value& params){
+	Value result;
+	RpcError error;
+
+	if(!trycommand(command, params, [&result](JsonScanner& scanner){ scanner.readValue(result); }, error)){
+		return error;
+	}
 	return result;
 }
 
+bool RaptoreumAPI::trycommand(const string& command, const Value& params,
+                              const std::function<void(JsonScanner&)>& decode, RpcError& error){
+	Clock::time_point start = startcall(command);
+	Value request;
+	request["jsonrpc"] = "1.0";
+	request["id"] = 1;
+	request["method"] = command;
+	request["params"] = params.isNull() ? Value(Json::arrayValue) : params;
+
+	/* A batch of one, which the daemon answers with HTTP 200 whatever the outcome */
+	Value batch(Json::arrayValue);
+	batch.append(request);
+
+	Json::FastWriter writer;
+	string response;
+	int code = 0;
+
+	try{
+		httpClient->SendRPCMessage(writer.write(batch), response);
+
+		JsonScanner scanner(response);
+		string key;
+
+		if(!scanner.beginArray() || !scanner.nextElement() || !scanner.beginObject()){
+			throw RaptoreumException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid response: null");
+		}
+
+		while(scanner.nextMember(key)){
+			if(key == "result" && !scanner.isNull()){
+				timedecode(decode, scanner);
+			}else if(key == "error" && !scanner.isNull()){
+				error = RpcError(RaptoreumException::fromErrorObject(scanner));
+				code = error.getCode();
+			}else if(key != "result" && key != "error"){
+				scanner.skipValue();
+			}
+		}
+	}
+	catch (JsonRpcException& e){
+		error = RpcError(RaptoreumException(e.GetCode(), e.GetMessage()));
+		code = error.getCode();
+	}
+	catch (RaptoreumException& e){
+		error = RpcError(e);
+		code = error.getCode();
+	}
+
+	endcall(command, 1, start, code);
+	return code == 0;
+}
+
 
 string RaptoreumAPI::IntegerToString(int num){
 	std::ostringstream ss;
@@ -85,6 +559,24 @@ double RaptoreumAPI::getAddressBalance(const string& account) {
 	return result["balance"].asDouble()/100000000;
 }
 
+map<string, double> RaptoreumAPI::getAddressBalance(const vector<string>& addresses, unsigned int batchSize, unsigned int threads) {
+	string command = "getaddressbalance";
+	vector<Value> params(addresses.size());
+	map<string, double> result;
+
+	/* The daemon sums {"addresses": [...]} into one balance, so ask per address */
+	for(unsigned i = 0; i < addresses.size(); ++i) {
+		params[i].append(addresses[i]);
+	}
+	vector<Value> resultRpc = sendbatch(command, params, batchSize, threads);
+
+	for(unsigned i = 0; i < addresses.size(); ++i) {
+		result[addresses[i]] = resultRpc[i]["balance"].asDouble()/100000000;
+	}
+
+	return result;
+}
+
 vector<string> RaptoreumAPI::getAddressOnlyTxs(const string& address) {
 	string command = "getaddresstxids";
 	Value params, resultRpc;
@@ -99,13 +591,168 @@ vector<string> RaptoreumAPI::getAddressOnlyTxs(const string& address) {
 	return result;
 }
 
+map<string, vector<string> > RaptoreumAPI::getAddressOnlyTxs(const vector<string>& addresses, unsigned int batchSize, unsigned int threads) {
+	string command = "getaddresstxids";
+	vector<Value> params(addresses.size());
+	map<string, vector<string> > result;
+
+	/* The daemon merges the txids of {"addresses": [...]}, so ask per address */
+	for(unsigned i = 0; i < addresses.size(); ++i) {
+		params[i].append(addresses[i]);
+	}
+	vector<Value> resultRpc = sendbatch(command, params, batchSize, threads);
+
+	for(unsigned i = 0; i < addresses.size(); ++i) {
+		vector<string>& txids = result[addresses[i]];
+		txids.reserve(resultRpc[i].size());
+		for(unsigned j = 0; j < resultRpc[i].size(); ++j) {
+			txids.push_back(resultRpc[i][j].asString());
+		}
+	}
+
+	return result;
+}
+
+/* === Address index === */
+
+static Value addressesParam(const vector<string>& addresses){
+	Value obj(Json::objectValue);
+	Value vec(Json::arrayValue);
+
+	for(unsigned i = 0; i < addresses.size(); ++i) {
+		vec.append(addresses[i]);
+	}
+	obj["addresses"] = vec;
+
+	return obj;
+}
+
+vector<addressdelta_t> RaptoreumAPI::getAddressDeltas(const vector<string>& addresses, int start, int end) {
+	string command = "getaddressdeltas";
+	Value params, query = addressesParam(addresses);
+	vector<addressdelta_t> ret;
+
+	if(start != 0 || end != 0) {
+		query["start"] = start;
+		query["end"] = end;
+	}
+	params.append(query);
+
+	sendcommand(command, params, [&ret](JsonScanner& scanner) {
+		string key;
+		if(!scanner.beginArray()) return;
+		while(scanner.nextElement()) {
+			ret.push_back(addressdelta_t());
+			addressdelta_t& delta = ret.back();
+			scanner.beginObject();
+			while(scanner.nextMember(key)) {
+				if(key == "satoshis") delta.satoshis = scanner.readInt();
+				else if(key == "txid") scanner.readString(delta.txid);
+				else if(key == "index") delta.index = scanner.readInt();
+				else if(key == "blockindex") delta.blockindex = scanner.readInt();
+				else if(key == "height") delta.height = scanner.readInt();
+				else if(key == "address") scanner.readString(delta.address);
+				else scanner.skipValue();
+			}
+		}
+	});
+
+	return ret;
+}
+
+vector<addressutxo_t> RaptoreumAPI::getAddressUtxos(const vector<string>& addresses) {
+	string command = "getaddressutxos";
+	Value params;
+	vector<addressutxo_t> ret;
+
+	params.append(addressesParam(addresses));
+
+	sendcommand(command, params, [&ret](JsonScanner& scanner) {
+		string key;
+		if(!scanner.beginArray()) return;
+		while(scanner.nextElement()) {
+			ret.push_back(addressutxo_t());
+			addressutxo_t& utxo = ret.back();
+			scanner.beginObject();
+			while(scanner.nextMember(key)) {
+				if(key == "address") scanner.readString(utxo.address);
+				else if(key == "txid") scanner.readString(utxo.txid);
+				else if(key == "outputIndex") utxo.outputIndex = scanner.readInt();
+				else if(key == "script") scanner.readString(utxo.script);
+				else if(key == "satoshis") utxo.satoshis = scanner.readInt();
+				else if(key == "height") utxo.height = scanner.readInt();
+				else scanner.skipValue();
+			}
+		}
+	});
+
+	return ret;
+}
+
+vector<addressmempool_t> RaptoreumAPI::getAddressMempool(const vector<string>& addresses) {
+	string command = "getaddressmempool";
+	Value params;
+	vector<addressmempool_t> ret;
+
+	params.append(addressesParam(addresses));
+
+	sendcommand(command, params, [&ret](JsonScanner& scanner) {
+		string key;
+		if(!scanner.beginArray()) return;
+		while(scanner.nextElement()) {
+			ret.push_back(addressmempool_t());
+			addressmempool_t& entry = ret.back();
+			scanner.beginObject();
+			while(scanner.nextMember(key)) {
+				if(key == "address") scanner.readString(entry.address);
+				else if(key == "txid") scanner.readString(entry.txid);
+				else if(key == "index") entry.index = scanner.readInt();
+				else if(key == "satoshis") entry.satoshis = scanner.readInt();
+				else if(key == "timestamp") entry.timestamp = scanner.readInt();
+				else if(key == "prevtxid") scanner.readString(entry.prevtxid);
+				else if(key == "prevout") entry.prevout = scanner.readInt();
+				else scanner.skipValue();
+			}
+		}
+	});
+
+	return ret;
+}
+
+spentinfo_t RaptoreumAPI::getSpentInfo(const string& txid, unsigned int index) {
+	string command = "getspentinfo";
+	Value params, query;
+	spentinfo_t ret;
+
+	query["txid"] = txid;
+	query["index"] = index;
+	params.append(query);
+
+	sendcommand(command, params, [&ret](JsonScanner& scanner) {
+		string key;
+		scanner.beginObject();
+		while(scanner.nextMember(key)) {
+			if(key == "txid") scanner.readString(ret.txid);
+			else if(key == "index") ret.index = scanner.readInt();
+			else if(key == "height") ret.height = scanner.readInt();
+			else scanner.skipValue();
+		}
+	});
+
+	return ret;
+}
+
 vector<gettransaction_t> RaptoreumAPI::getAddressTxs(const string& address, int count, int from) {
 
 	vector<string> txIds = getAddressOnlyTxs(address);
 	vector<gettransaction_t> result;
 	gettransaction_t tx;
 	
-	for(unsigned i = 0; i < 5; ++i) {
+	/* count transactions starting at from, within the ones there are */
+	size_t first = std::min((size_t) std::max(from, 0), txIds.size());
+	size_t last = std::min(first + std::max(count, 0), txIds.size());
+
+	for(size_t i = first; i < last; ++i) {
 		tx = getTransaction(txIds[i]);
 		result.push_back(tx);
 	}
@@ -137,57 +784,379 @@ mininginfo_t RaptoreumAPI::getMiningInfo() {
 	return ret;
 }
 
+/* === Blocks === */
+
+string RaptoreumAPI::getBestBlockHash() {
+	string command = "getbestblockhash";
+	Value params, result;
+	result = sendcommand(command, params);
+
+	return result.asString();
+}
+
+string RaptoreumAPI::getBlockHash(int height) {
+	string command = "getblockhash";
+	Value params, result;
+	params.append(height);
+	result = sendcommand(command, params);
+
+	return result.asString();
+}
+
+blockinfo_t RaptoreumAPI::getBlock(const string& blockhash) {
+	blockinfo_t ret;
+
+	getBlock(blockhash, ret);
+
+	return ret;
+}
+
+void RaptoreumAPI::getBlock(const string& blockhash, blockinfo_t& ret) {
+	string command = "getblock";
+	Value params;
+
+	params.append(blockhash);
+	params.append(true);
+
+	/* Cleared rather than replaced, so the strings keep their capacity */
+	ret.hash.clear();
+	ret.confirmations = ret.size = ret.height = ret.version = 0;
+	ret.merkleroot.clear();
+	ret.time = ret.nonce = 0;
+	ret.bits.clear();
+	ret.difficulty = 0;
+	ret.chainwork.clear();
+	ret.previousblockhash.clear();
+	ret.nextblockhash.clear();
+
+	sendcommand(command, params, [&ret](JsonScanner& scanner) {
+		string key;
+		size_t tx = 0;
+		scanner.beginObject();
+		while(scanner.nextMember(key)) {
+			if(key == "hash") scanner.readString(ret.hash);
+			else if(key == "confirmations") ret.confirmations = scanner.readInt();
+			else if(key == "size") ret.size = scanner.readInt();
+			else if(key == "height") ret.height = scanner.readInt();
+			else if(key == "version") ret.version = scanner.readInt();
+			else if(key == "merkleroot") scanner.readString(ret.merkleroot);
+			else if(key == "tx" && scanner.beginArray()) {
+				while(scanner.nextElement()) {
+					if(tx == ret.tx.size()) ret.tx.resize(tx + 1);
+					scanner.readString(ret.tx[tx++]);
+				}
+			}
+			else if(key == "time") ret.time = scanner.readInt();
+			else if(key == "nonce") ret.nonce = scanner.readInt();
+			else if(key == "bits") scanner.readString(ret.bits);
+			else if(key == "difficulty") ret.difficulty = scanner.readDouble();
+			else if(key == "chainwork") scanner.readString(ret.chainwork);
+			else if(key == "previousblockhash") scanner.readString(ret.previousblockhash);
+			else if(key == "nextblockhash") scanner.readString(ret.nextblockhash);
+			else if(key != "tx") scanner.skipValue();
+		}
+		ret.tx.resize(tx);
+	});
+}
+
+rawblock_t RaptoreumAPI::getBlockRaw(const string& blockhash, const chainparams_t& chainparams, unsigned int threads) {
+	string command = "getblock";
+	Value params;
+	string hex;
+	rawblock_t ret;
+
+	params.append(blockhash);
+	params.append(false);
+
+	sendcommand(command, params, [&hex](JsonScanner& scanner) {
+		scanner.readString(hex);
+	});
+
+	DecodeRawBlock(hex, ret, chainparams, threads);
+
+	/* The header hash is computed locally, so the response can be checked */
+	if(ret.hash != blockhash){
+		throw RaptoreumException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid response: block hash mismatch");
+	}
+
+	return ret;
+}
+
+int RaptoreumAPI::getBlockCount() {
+	string command = "getblockcount";
+	Value params, result;
+	result = sendcommand(command, params);
+
+	return result.asInt();
+}
+
 /* === Raw transaction calls === */
-// Probably dont work fine
+/* Result of getrawtransaction, a hex string unless verbose, scanned into
+   ret in place. Inputs, outputs and addresses already in ret are
+   overwritten in order, so their strings keep their capacity, and only
+   the surplus is dropped. */
+static void scanRawTransactionResult(JsonScanner& scanner, int verbose, getrawtransaction_t& ret){
+	ret.txid.clear();
+	ret.size = 0;
+	ret.version = ret.type = ret.locktime = 0;
+	ret.extraPayload.clear();
+	ret.blockhash.clear();
+	ret.confirmations = ret.time = ret.blocktime = 0;
+
+	if(verbose == 0){
+		ret.vin.clear();
+		ret.vout.clear();
+		scanner.readString(ret.hex);
+		return;
+	}
+
+	string key, inner;
+	size_t vin = 0, vout = 0;
+	ret.hex.clear();
+
+	scanner.beginObject();
+	while(scanner.nextMember(key)){
+		if(key == "hex") scanner.readString(ret.hex);
+		else if(key == "txid") scanner.readString(ret.txid);
+		else if(key == "size") ret.size = (unsigned int) scanner.readInt();
+		else if(key == "version") ret.version = (int) scanner.readInt();
+		else if(key == "type") ret.type = (int) scanner.readInt();
+		else if(key == "locktime") ret.locktime = (int) scanner.readInt();
+		else if(key == "extraPayload") scanner.readString(ret.extraPayload);
+		else if(key == "blockhash") scanner.readString(ret.blockhash);
+		else if(key == "confirmations") ret.confirmations = (unsigned int) scanner.readInt();
+		else if(key == "time") ret.time = (unsigned int) scanner.readInt();
+		else if(key == "blocktime") ret.blocktime = (unsigned int) scanner.readInt();
+		else if(key == "vin" && scanner.beginArray()){
+			while(scanner.nextElement()){
+				if(vin == ret.vin.size()) ret.vin.resize(vin + 1);
+				vin_t& input = ret.vin[vin++];
+				input.coinbase.clear();
+				input.txid.clear();
+				input.n = 0;
+				input.scriptSig.assm.clear();
+				input.scriptSig.hex.clear();
+				input.sequence = 0;
+
+				if(!scanner.beginObject()) continue;
+				while(scanner.nextMember(key)){
+					if(key == "coinbase") scanner.readString(input.coinbase);
+					else if(key == "txid") scanner.readString(input.txid);
+					else if(key == "vout") input.n = (unsigned int) scanner.readInt();
+					else if(key == "sequence") input.sequence = (unsigned int) scanner.readInt();
+					else if(key == "scriptSig" && scanner.beginObject()){
+						while(scanner.nextMember(inner)){
+							if(inner == "asm") scanner.readString(input.scriptSig.assm);
+							else if(inner == "hex") scanner.readString(input.scriptSig.hex);
+							else scanner.skipValue();
+						}
+					}
+					else if(key != "scriptSig") scanner.skipValue();
+				}
+			}
+		}
+		else if(key == "vout" && scanner.beginArray()){
+			while(scanner.nextElement()){
+				if(vout == ret.vout.size()) ret.vout.resize(vout + 1);
+				vout_t& output = ret.vout[vout++];
+				scriptPubKey_t& spk = output.scriptPubKey;
+				size_t addresses = 0;
+				bool valueSat = false;
+				output.value = 0;
+				output.valueSat = 0;
+				output.n = 0;
+				spk.assm.clear();
+				spk.hex.clear();
+				spk.reqSigs = 0;
+				spk.type.clear();
+
+				if(scanner.beginObject()){
+					while(scanner.nextMember(key)){
+						/* Exact satoshis from the decimal amount, unless valueSat is given */
+						if(key == "value"){
+							int64_t amount = scanner.readAmount();
+							output.value = amount / 100000000.0;
+							if(!valueSat) output.valueSat = amount;
+						}
+						else if(key == "valueSat"){
+							output.valueSat = scanner.readInt();
+							valueSat = true;
+						}
+						else if(key == "n") output.n = (unsigned int) scanner.readInt();
+						else if(key == "scriptPubKey" && scanner.beginObject()){
+							while(scanner.nextMember(inner)){
+								if(inner == "asm") scanner.readString(spk.assm);
+								else if(inner == "hex") scanner.readString(spk.hex);
+								else if(inner == "reqSigs") spk.reqSigs = (int) scanner.readInt();
+								else if(inner == "type") scanner.readString(spk.type);
+								else if(inner == "addresses" && scanner.beginArray()){
+									while(scanner.nextElement()){
+										if(addresses == spk.addresses.size()) spk.addresses.resize(addresses + 1);
+										scanner.readString(spk.addresses[addresses++]);
+									}
+								}
+								else if(inner != "addresses") scanner.skipValue();
+							}
+						}
+						else if(key != "scriptPubKey") scanner.skipValue();
+					}
+				}
+				spk.addresses.resize(addresses);
+			}
+		}
+		else if(key != "vin" && key != "vout") scanner.skipValue();
+	}
+
+	ret.vin.resize(vin);
+	ret.vout.resize(vout);
+}
+
 getrawtransaction_t RaptoreumAPI::getRawTransaction(const string& txid, int verbose) {
+	getrawtransaction_t ret;
+
+	getRawTransaction(txid, verbose, ret);
+
+	return ret;
+}
+
+void RaptoreumAPI::getRawTransaction(const string& txid, int verbose, getrawtransaction_t& ret) {
 	string command = "getrawtransaction";
-	Value params, result;
+	Value params;
+
+	params.append(txid);
+	params.append(verbose);
+
+	sendcommand(command, params, [&ret, verbose](JsonScanner& scanner){
+		scanRawTransactionResult(scanner, verbose, ret);
+	});
+}
+
+getrawtransaction_t RaptoreumAPI::getRawTransactionDecoded(const string& txid, const chainparams_t& chainparams) {
+	getrawtransaction_t ret;
+
+	getRawTransactionDecoded(txid, ret, chainparams);
+
+	return ret;
+}
+
+void RaptoreumAPI::getRawTransactionDecoded(const string& txid, getrawtransaction_t& ret,
+                                            const chainparams_t& chainparams) {
+	string command = "getrawtransaction";
+	Value params;
+
+	params.append(txid);
+	params.append(0);
+
+	/* The result is a single string, scan it without building a Value */
+	sendcommand(command, params, [&ret](JsonScanner& scanner){
+		scanner.readString(ret.hex);
+	});
+
+	DecodeRawTransaction(ret.hex, ret, chainparams);
+	ret.blockhash.clear();
+	ret.confirmations = 0;
+	ret.time = 0;
+	ret.blocktime = 0;
+}
+
+Result<getrawtransaction_t> RaptoreumAPI::tryGetRawTransaction(const string& txid, int verbose) {
+	string command = "getrawtransaction";
+	Value params;
 	getrawtransaction_t ret;
+	RpcError error;
 
 	params.append(txid);
 	params.append(verbose);
-	result = sendcommand(command, params);
 
-	ret.hex = ((verbose == 0) ? result.asString() : result["hex"].asString());
-
-	if(verbose != 0){
-		ret.txid = result["txid"].asString();
-		ret.version = result["version"].asInt();
-		ret.locktime = result["locktime"].asInt();
-		for (ValueIterator it = result["vin"].begin(); it != result["vin"].end();
-				it++) {
-			Value val = (*it);
-			vin_t input;
-			input.txid = val["txid"].asString();
-			input.n = val["vout"].asUInt();
-			input.scriptSig.assm = val["scriptSig"]["asm"].asString();
-			input.scriptSig.hex = val["scriptSig"]["hex"].asString();
-			input.sequence = val["sequence"].asUInt();
-			ret.vin.push_back(input);
-		}
-
-		for (ValueIterator it = result["vout"].begin(); it != result["vout"].end();
-				it++) {
-			Value val = (*it);
-			vout_t output;
-
-			output.value = val["value"].asDouble();
-			output.n = val["n"].asUInt();
-			output.scriptPubKey.assm = val["scriptPubKey"]["asm"].asString();
-			output.scriptPubKey.hex = val["scriptPubKey"]["hex"].asString();
-			output.scriptPubKey.reqSigs = val["scriptPubKey"]["reqSigs"].asInt();
-
-			output.scriptPubKey.type = val["scriptPubKey"]["type"].asString();
-			for(ValueIterator it2 = val["scriptPubKey"]["addresses"].begin(); it2 != val["scriptPubKey"]["addresses"].end(); it2++){
-				output.scriptPubKey.addresses.push_back((*it2).asString());
-			}
+	if(!trycommand(command, params, [&ret, verbose](JsonScanner& scanner){
+		scanRawTransactionResult(scanner, verbose, ret);
+	}, error)){
+		return error;
+	}
+
+	return ret;
+}
+
+Result<getrawtransaction_t> RaptoreumAPI::tryGetRawTransactionDecoded(const string& txid, const chainparams_t& chainparams) {
+	string command = "getrawtransaction";
+	Value params;
+	getrawtransaction_t ret;
+	RpcError error;
+
+	params.append(txid);
+	params.append(0);
+
+	if(!trycommand(command, params, [&ret](JsonScanner& scanner){ scanner.readString(ret.hex); }, error)){
+		return error;
+	}
+
+	try{
+		DecodeRawTransaction(ret.hex, ret, chainparams);
+	}
+	catch (RaptoreumException& e){
+		return RpcError(e);
+	}
+	catch (std::exception& e){
+		return RpcError(RPC_DESERIALIZATION_ERROR, e.what());
+	}
+	ret.confirmations = 0;
+	ret.time = 0;
+	ret.blocktime = 0;
+
+	return ret;
+}
+
+vector<Result<getrawtransaction_t> > RaptoreumAPI::tryGetRawTransactions(const vector<string>& txids, int verbose,
+                                                                         unsigned int batchSize) {
+	string command = "getrawtransaction";
+	vector<Value> params(txids.size());
+	vector<getrawtransaction_t> txs(txids.size());
+	vector<RpcError> errors;
+	vector<Result<getrawtransaction_t> > ret;
+
+	for(unsigned i = 0; i < txids.size(); ++i) {
+		params[i].append(txids[i]);
+		params[i].append(verbose);
+	}
 
-			ret.vout.push_back(output);
+	try{
+		scanbatch(command, params, [&txs, verbose](size_t i, JsonScanner& scanner){
+			scanRawTransactionResult(scanner, verbose, txs[i]);
+		}, errors, batchSize, 4);
+	}
+	catch (RaptoreumException& e){
+		/* The transport failed, and with it every call */
+		ret.assign(txids.size(), RpcError(e));
+		return ret;
+	}
+
+	ret.reserve(txids.size());
+	for(unsigned i = 0; i < txids.size(); ++i) {
+		if(errors[i].getCode() != 0) {
+			ret.push_back(errors[i]);
+		}else{
+			ret.push_back(txs[i]);
+		}
+	}
+
+	return ret;
+}
+
+
+vector<string> RaptoreumAPI::sendRawTransactions(const vector<string>& hexes, vector<int>& errors, unsigned int batchSize) {
+	string command = "sendrawtransaction";
+	vector<Value> params(hexes.size());
+	vector<string> ret(hexes.size());
+
+	for(unsigned i = 0; i < hexes.size(); ++i) {
+		params[i].append(hexes[i]);
+	}
+	vector<Value> resultRpc = sendbatch(command, params, errors, batchSize);
+
+	for(unsigned i = 0; i < hexes.size(); ++i) {
+		if(errors[i] == 0) {
+			ret[i] = resultRpc[i].asString();
 		}
-		ret.blockhash = result["blockhash"].asString();
-		ret.confirmations = result["confirmations"].asUInt();
-		ret.time = result["time"].asUInt();
-		ret.blocktime = result["blocktime"].asUInt();
 	}
 
 	return ret;
@@ -236,3 +1205,72 @@ gettransaction_t RaptoreumAPI::getTransaction(const string& tx) {
 
 	return ret;
 }
+
+/* === Mempool === */
+
+vector<string> RaptoreumAPI::getRawMempool() {
+	string command = "getrawmempool";
+	Value params;
+	vector<string> ret;
+
+	params.append(false);
+
+	sendcommand(command, params, [&ret](JsonScanner& scanner) {
+		if(!scanner.beginArray()) return;
+		while(scanner.nextElement()) {
+			ret.push_back(string());
+			scanner.readString(ret.back());
+		}
+	});
+
+	return ret;
+}
+
+static void decodeMempoolEntry(const Value& val, mempoolentry_t& entry) {
+	entry.size = val["size"].asUInt();
+	entry.time = val["time"].asUInt();
+	entry.height = val["height"].asUInt();
+
+	/* Newer daemons move the fee into "fees" */
+	double fee = val.isMember("fees") ? val["fees"]["base"].asDouble() : val["fee"].asDouble();
+	entry.fee = (int64_t) std::llround(fee * 100000000.0);
+	entry.feerate = (entry.size > 0) ? entry.fee * 1000 / entry.size : 0;
+}
+
+mempoolentry_t RaptoreumAPI::getMempoolEntry(const string& txid) {
+	string command = "getmempoolentry";
+	Value params, result;
+	mempoolentry_t ret;
+
+	params.append(txid);
+	result = sendcommand(command, params);
+
+	ret.txid = txid;
+	decodeMempoolEntry(result, ret);
+
+	return ret;
+}
+
+vector<mempoolentry_t> RaptoreumAPI::getMempoolEntries(const vector<string>& txids, unsigned int batchSize) {
+	string command = "getmempoolentry";
+	vector<Value> params(txids.size());
+	vector<int> errors;
+	vector<mempoolentry_t> ret;
+
+	for(unsigned i = 0; i < txids.size(); ++i) {
+		params[i].append(txids[i]);
+	}
+	vector<Value> resultRpc = sendbatch(command, params, errors, batchSize);
+
+	ret.reserve(txids.size());
+	for(unsigned i = 0; i < txids.size(); ++i) {
+		if(errors[i] != 0) {
+			continue;
+		}
+		ret.push_back(mempoolentry_t());
+		ret.back().txid = txids[i];
+		decodeMempoolEntry(resultRpc[i], ret.back());
+	}
+
+	return ret;
+}
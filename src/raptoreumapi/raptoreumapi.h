@@ -13,6 +13,11 @@
 
 #include "types.h"
 #include "exception.h"
+#include "jsonscanner.h"
+#include "result.h"
+#include "script.h"
+
+#include <functional>
 
 namespace jsonrpc { class HttpClient; class Client; }
 
@@ -20,19 +25,58 @@ class RaptoreumAPI
 {
 
 private:
+    std::string url;
+    int httpTimeout;
     jsonrpc::HttpClient * httpClient;
     jsonrpc::Client * client;
 
+    RaptoreumAPI& operator=(const RaptoreumAPI& other);
+
+    std::vector<Json::Value> batchcommand(const std::string& command, const std::vector<Json::Value>& params,
+                                          std::vector<int>* errors, unsigned int batchSize, unsigned int threads);
+
+    // As sendbatch, but decode(i, scanner) decodes the result of params[i] while
+    // it is scanned, and a failed call leaves its error in errors[i]
+    void scanbatch(const std::string& command, const std::vector<Json::Value>& params,
+                   const std::function<void(size_t, JsonScanner&)>& decode, std::vector<RpcError>& errors,
+                   unsigned int batchSize, unsigned int threads);
+
 public:
     /* === Constructor and Destructor === */
     
+    // host may name the scheme, e.g. "http://127.0.0.1" for a local mock daemon; https otherwise
     RaptoreumAPI(const std::string& user, const std::string& password, const std::string& host, int port, int httpTimeout = 50000);
+    // Opens a separate connection to the same daemon, e.g. for a worker thread
+    RaptoreumAPI(const RaptoreumAPI& other);
     ~RaptoreumAPI();
 
     /* === Auxiliary functions === */
     
     Json::Value sendcommand(const std::string& command, const Json::Value& params);
 
+    // Same call, but the response is decoded by decode while it is scanned
+    // instead of being built into a Json::Value first.
+    void sendcommand(const std::string& command, const Json::Value& params,
+                     const std::function<void(JsonScanner&)>& decode);
+
+    // One call of command per params entry, sent as JSON-RPC batches of batchSize
+    // calls over up to threads connections. Results keep the order of params.
+    std::vector<Json::Value> sendbatch(const std::string& command, const std::vector<Json::Value>& params,
+                                       unsigned int batchSize = 100, unsigned int threads = 4);
+
+    // As above, but a failed call leaves a null result and its code in errors instead of throwing
+    std::vector<Json::Value> sendbatch(const std::string& command, const std::vector<Json::Value>& params,
+                                       std::vector<int>& errors, unsigned int batchSize = 100, unsigned int threads = 4);
+
+    // As sendcommand, but a failure is returned instead of thrown. The call goes
+    // out as a batch of one, which the daemon answers with HTTP 200 even when
+    // the call fails, so nothing throws on the way.
+    Result<Json::Value> trycommand(const std::string& command, const Json::Value& params);
+
+    // Decodes while scanning; false with error set when the call failed
+    bool trycommand(const std::string& command, const Json::Value& params,
+                    const std::function<void(JsonScanner&)>& decode, RpcError& error);
+
     std::string IntegerToString(int num);    
     std::string RoundDouble(double num);
 
@@ -40,22 +84,83 @@ public:
     
     // Address balance
     double getAddressBalance(const std::string& account);
+    // One call per address, see sendbatch for batchSize and threads
+    std::map<std::string, double> getAddressBalance(const std::vector<std::string>& addresses,
+                                                    unsigned int batchSize = 100, unsigned int threads = 4);
 
 	// Vector with all Tx Ids (without more info)
     std::vector<std::string> getAddressOnlyTxs(const std::string& address);
+    std::map<std::string, std::vector<std::string> > getAddressOnlyTxs(const std::vector<std::string>& addresses,
+                                                                       unsigned int batchSize = 100, unsigned int threads = 4);
     
     // Vector with all TxIds + advanced info
     std::vector<gettransaction_t> getAddressTxs(const std::string& address, int count = 10, int from = 0);
     
     // Get details from one tx
     gettransaction_t getTransaction(const std::string& tx);
+
+    /* === Address index === */
+
+    // Balance changes, limited to blocks [start, end] when both are set
+    std::vector<addressdelta_t> getAddressDeltas(const std::vector<std::string>& addresses, int start = 0, int end = 0);
+    std::vector<addressutxo_t> getAddressUtxos(const std::vector<std::string>& addresses);
+    std::vector<addressmempool_t> getAddressMempool(const std::vector<std::string>& addresses);
+
+    // Where the output index of txid was spent
+    spentinfo_t getSpentInfo(const std::string& txid, unsigned int index);
     
     /* === Mining functions === */
     mininginfo_t getMiningInfo();
+
+    /* === Blocks === */
+    std::string getBestBlockHash();
+    std::string getBlockHash(int height);
+    blockinfo_t getBlock(const std::string& blockhash);
+    // Decodes into out, reusing the capacity of its strings and vectors
+    void getBlock(const std::string& blockhash, blockinfo_t& out);
+    int getBlockCount();
+
+    // Fetches the serialized block (verbosity 0) and decodes header and
+    // transactions locally, see DecodeBlock for the threads argument
+    rawblock_t getBlockRaw(const std::string& blockhash,
+                           const chainparams_t& chainparams = MainNetParams(), unsigned int threads = 0);
     
 
     /* === Low level calls === */
     getrawtransaction_t getRawTransaction(const std::string& txid, int verbose = 0);
+
+    // Decode into out, reusing the capacity of its strings and vectors and
+    // of the inputs and outputs already there, so a loop passing the same
+    // object settles to no allocations for the decoding. Fields missing
+    // from the response are reset; without verbose only hex is set.
+    void getRawTransaction(const std::string& txid, int verbose, getrawtransaction_t& out);
+    void getRawTransactionDecoded(const std::string& txid, getrawtransaction_t& out,
+                                  const chainparams_t& chainparams = MainNetParams());
+
+    // Fetches the raw bytes only (verbose=0) and decodes them locally.
+    // The block fields are not part of the raw form and stay empty.
+    getrawtransaction_t getRawTransactionDecoded(const std::string& txid,
+                                                 const chainparams_t& chainparams = MainNetParams());
+
+    // The same without throwing, for lookup loops where many txids are unknown
+    Result<getrawtransaction_t> tryGetRawTransaction(const std::string& txid, int verbose = 0);
+    Result<getrawtransaction_t> tryGetRawTransactionDecoded(const std::string& txid,
+                                                            const chainparams_t& chainparams = MainNetParams());
+    // Batched, one result per txid in order
+    std::vector<Result<getrawtransaction_t> > tryGetRawTransactions(const std::vector<std::string>& txids,
+                                                                    int verbose = 0, unsigned int batchSize = 500);
+
+    // Broadcasts signed transactions with batched sendrawtransaction calls.
+    // Returns the txids in order, empty where the daemon rejected the
+    // transaction, with the rejection code in errors.
+    std::vector<std::string> sendRawTransactions(const std::vector<std::string>& hexes, std::vector<int>& errors,
+                                                 unsigned int batchSize = 500);
+
+    /* === Mempool === */
+    std::vector<std::string> getRawMempool();
+    mempoolentry_t getMempoolEntry(const std::string& txid);
+    // Batched lookup, txids that already left the mempool are skipped
+    std::vector<mempoolentry_t> getMempoolEntries(const std::vector<std::string>& txids, unsigned int batchSize = 500);
 };
 
 
@@ -0,0 +1,82 @@
+/**
+ * @file    result.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of the value or error returned by the calls
+ * that report failure without throwing.
+ */
+
+#ifndef RAPTOREUM_API_RESULT_H
+#define RAPTOREUM_API_RESULT_H
+
+#include "exception.h"
+
+#include <string>
+
+/* What a RaptoreumException would have carried */
+class RpcError
+{
+
+private:
+    RaptoreumException exception;
+
+public:
+    RpcError() { }
+    explicit RpcError(const RaptoreumException& e) : exception(e) { }
+    // Error found on the client side, with a code from rpcerror
+    RpcError(int code, const std::string& message) { exception.setDaemonError(code, message); }
+
+    int getCode() const { return exception.getCode(); }
+    rpcerror getError() const { return exception.getError(); }
+    std::string getMessage() const { return exception.getMessage(); }
+
+    // For callers that want to throw after all
+    const RaptoreumException& toException() const { return exception; }
+};
+
+/*
+ * Either a value or an error, e.g.
+ *
+ *   Result<getrawtransaction_t> tx = btc.tryGetRawTransaction(txid, 1);
+ *   if(tx) use(tx.value());
+ *   else if(tx.error().getError() != RPC_INVALID_ADDRESS_OR_KEY) report(tx.error());
+ */
+template<typename T, typename E = RpcError>
+class Result
+{
+
+private:
+    bool ok;
+    T val;
+    E err;
+
+public:
+    Result() : ok(false) { }
+    Result(const T& value) : ok(true), val(value) { }
+    Result(const E& error) : ok(false), err(error) { }
+
+    bool isOk() const { return ok; }
+    explicit operator bool() const { return ok; }
+
+    // Throw the error as RaptoreumException when there is no value
+    const T& value() const {
+        if(!ok){
+            throw err.toException();
+        }
+        return val;
+    }
+    T& value() {
+        if(!ok){
+            throw err.toException();
+        }
+        return val;
+    }
+    T valueOr(const T& fallback) const { return ok ? val : fallback; }
+
+    const E& error() const { return err; }
+};
+
+
+#endif
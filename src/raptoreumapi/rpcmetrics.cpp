@@ -0,0 +1,338 @@
+/**
+ * @file    rpcmetrics.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of the process wide registry of per
+ * method RPC metrics.
+ */
+
+#include "rpcmetrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+using std::string;
+using std::vector;
+
+const int64_t RpcMetrics::LATENCY_BOUNDS[RpcMetrics::LATENCY_BUCKETS] = {
+	100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000,
+	100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000
+};
+
+namespace {
+
+/* Counters of one method on one thread. Only the owning thread writes
+   them, readers sum them up with relaxed loads. */
+struct methodcounters_t{
+	std::atomic<uint64_t> calls;
+	std::atomic<uint64_t> errors;
+	std::atomic<uint64_t> requestBytes;
+	std::atomic<uint64_t> responseBytes;
+	std::atomic<uint64_t> roundTrips;
+	std::atomic<uint64_t> latencySum;
+	std::atomic<uint64_t> latency[RpcMetrics::LATENCY_BUCKETS + 1];
+
+	// errorCode[i] and errorCount[i] are valid below errorCodes, which is published last
+	std::atomic<int> errorCodes;
+	std::atomic<int> errorCode[RpcMetrics::MAX_ERROR_CODES];
+	std::atomic<uint64_t> errorCount[RpcMetrics::MAX_ERROR_CODES];
+
+	methodcounters_t()
+	: calls(0), errors(0), requestBytes(0), responseBytes(0), roundTrips(0), latencySum(0), errorCodes(0)
+	{
+		for(int i = 0; i <= RpcMetrics::LATENCY_BUCKETS; ++i){
+			latency[i].store(0, std::memory_order_relaxed);
+		}
+		for(int i = 0; i < RpcMetrics::MAX_ERROR_CODES; ++i){
+			errorCode[i].store(0, std::memory_order_relaxed);
+			errorCount[i].store(0, std::memory_order_relaxed);
+		}
+	}
+};
+
+/* All counters of one thread, indexed like registry_t::names with "other"
+   last. Handed to the next new thread once its owner exits. */
+struct shard_t{
+	std::atomic<methodcounters_t*> methods[RpcMetrics::MAX_METHODS + 1];
+	bool used;
+	shard_t * next;
+
+	shard_t() : used(true), next(NULL) {
+		for(int i = 0; i <= RpcMetrics::MAX_METHODS; ++i){
+			methods[i].store(NULL, std::memory_order_relaxed);
+		}
+	}
+};
+
+struct registry_t{
+	std::mutex mutex;                       // guards all but enabled
+	vector<string> names;
+	std::unordered_map<string, int> indexes;
+	shard_t * shards;
+	std::atomic<bool> enabled;
+
+	registry_t() : shards(NULL), enabled(true) { }
+};
+
+/* Never destroyed, threads may still record while statics go away at exit */
+registry_t& registry(){
+	static registry_t * instance = new registry_t();
+	return *instance;
+}
+
+struct threadstate_t{
+	shard_t * shard;
+	std::unordered_map<string, int> indexes;
+
+	threadstate_t() : shard(NULL) { }
+
+	~threadstate_t(){
+		if(shard != NULL){
+			std::lock_guard<std::mutex> lock(registry().mutex);
+			shard->used = false;
+		}
+	}
+};
+
+thread_local threadstate_t state;
+
+/* Single writer, so a plain load and store is enough */
+inline void add(std::atomic<uint64_t>& counter, uint64_t n){
+	counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+/* Counters of method on the calling thread, created on first use */
+methodcounters_t& counters(const string& method){
+	registry_t& reg = registry();
+	int index;
+
+	std::unordered_map<string, int>::const_iterator it = state.indexes.find(method);
+	if(it != state.indexes.end()){
+		index = it->second;
+	}else{
+		std::lock_guard<std::mutex> lock(reg.mutex);
+
+		if(state.shard == NULL){
+			shard_t * shard = reg.shards;
+			while(shard != NULL && shard->used){
+				shard = shard->next;
+			}
+			if(shard == NULL){
+				shard = new shard_t();
+				shard->next = reg.shards;
+				reg.shards = shard;
+			}
+			shard->used = true;
+			state.shard = shard;
+		}
+
+		std::unordered_map<string, int>::const_iterator known = reg.indexes.find(method);
+		if(known != reg.indexes.end()){
+			index = known->second;
+		}else if(reg.names.size() < (size_t) RpcMetrics::MAX_METHODS){
+			index = reg.names.size();
+			reg.names.push_back(method);
+			reg.indexes[method] = index;
+		}else{
+			index = RpcMetrics::MAX_METHODS;
+		}
+		state.indexes[method] = index;
+	}
+
+	methodcounters_t * ret = state.shard->methods[index].load(std::memory_order_relaxed);
+	if(ret == NULL){
+		ret = new methodcounters_t();
+		state.shard->methods[index].store(ret, std::memory_order_release);
+	}
+	return *ret;
+}
+
+/* Adds the counters of every thread for method index */
+void collect(const registry_t& reg, int index, rpcmethodstats_t& stats){
+	stats.calls = stats.errors = stats.requestBytes = stats.responseBytes = 0;
+	stats.roundTrips = stats.latencySum = 0;
+	stats.errorCodes.clear();
+	stats.latencyBuckets.assign(RpcMetrics::LATENCY_BUCKETS + 1, 0);
+
+	for(const shard_t * shard = reg.shards; shard != NULL; shard = shard->next){
+		const methodcounters_t * c = shard->methods[index].load(std::memory_order_acquire);
+		if(c == NULL){
+			continue;
+		}
+
+		stats.calls += c->calls.load(std::memory_order_relaxed);
+		stats.errors += c->errors.load(std::memory_order_relaxed);
+		stats.requestBytes += c->requestBytes.load(std::memory_order_relaxed);
+		stats.responseBytes += c->responseBytes.load(std::memory_order_relaxed);
+		stats.roundTrips += c->roundTrips.load(std::memory_order_relaxed);
+		stats.latencySum += c->latencySum.load(std::memory_order_relaxed);
+		for(int i = 0; i <= RpcMetrics::LATENCY_BUCKETS; ++i){
+			stats.latencyBuckets[i] += c->latency[i].load(std::memory_order_relaxed);
+		}
+
+		int codes = c->errorCodes.load(std::memory_order_acquire);
+		for(int i = 0; i < codes; ++i){
+			stats.errorCodes[c->errorCode[i].load(std::memory_order_relaxed)] +=
+				c->errorCount[i].load(std::memory_order_relaxed);
+		}
+	}
+}
+
+string escapeLabel(const string& value){
+	string ret;
+	for(size_t i = 0; i < value.size(); ++i){
+		if(value[i] == '\\' || value[i] == '"'){
+			ret += '\\';
+			ret += value[i];
+		}else if(value[i] == '\n'){
+			ret += "\\n";
+		}else{
+			ret += value[i];
+		}
+	}
+	return ret;
+}
+
+}
+
+
+void RpcMetrics::setEnabled(bool enabled){
+	registry().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool RpcMetrics::isEnabled(){
+	return registry().enabled.load(std::memory_order_relaxed);
+}
+
+void RpcMetrics::record(const string& method, unsigned int calls, int64_t latency,
+                        size_t requestBytes, size_t responseBytes){
+	if(!isEnabled()){
+		return;
+	}
+
+	methodcounters_t& c = counters(method);
+	latency = std::max(latency, (int64_t) 0);
+
+	add(c.calls, calls);
+	add(c.requestBytes, requestBytes);
+	add(c.responseBytes, responseBytes);
+	add(c.roundTrips, 1);
+	add(c.latencySum, latency);
+	add(c.latency[std::lower_bound(LATENCY_BOUNDS, LATENCY_BOUNDS + LATENCY_BUCKETS, latency) - LATENCY_BOUNDS], 1);
+}
+
+void RpcMetrics::recordError(const string& method, int code, unsigned int calls){
+	if(!isEnabled()){
+		return;
+	}
+
+	methodcounters_t& c = counters(method);
+	add(c.errors, calls);
+
+	int codes = c.errorCodes.load(std::memory_order_relaxed);
+	for(int i = 0; i < codes; ++i){
+		if(c.errorCode[i].load(std::memory_order_relaxed) == code){
+			add(c.errorCount[i], calls);
+			return;
+		}
+	}
+	if(codes < MAX_ERROR_CODES){
+		c.errorCode[codes].store(code, std::memory_order_relaxed);
+		c.errorCount[codes].store(calls, std::memory_order_relaxed);
+		c.errorCodes.store(codes + 1, std::memory_order_release);
+	}
+}
+
+vector<rpcmethodstats_t> RpcMetrics::getStats(){
+	registry_t& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	vector<rpcmethodstats_t> ret;
+
+	for(int i = 0; i <= (int) reg.names.size(); ++i){
+		int index = (i < (int) reg.names.size()) ? i : MAX_METHODS;
+		rpcmethodstats_t stats;
+		stats.method = (index < MAX_METHODS) ? reg.names[index] : "other";
+		collect(reg, index, stats);
+		if(stats.roundTrips > 0 || stats.errors > 0){
+			ret.push_back(stats);
+		}
+	}
+
+	std::sort(ret.begin(), ret.end(), [](const rpcmethodstats_t& a, const rpcmethodstats_t& b){
+		return a.method < b.method;
+	});
+	return ret;
+}
+
+string RpcMetrics::getPrometheusText(){
+	vector<rpcmethodstats_t> stats = getStats();
+	std::ostringstream out;
+
+	out << "# HELP raptoreumapi_rpc_calls_total RPC calls sent, counting each call of a batch.\n"
+	    << "# TYPE raptoreumapi_rpc_calls_total counter\n";
+	for(size_t m = 0; m < stats.size(); ++m){
+		out << "raptoreumapi_rpc_calls_total{method=\"" << escapeLabel(stats[m].method) << "\"} "
+		    << stats[m].calls << "\n";
+	}
+
+	out << "# HELP raptoreumapi_rpc_errors_total Failed RPC calls by error code.\n"
+	    << "# TYPE raptoreumapi_rpc_errors_total counter\n";
+	for(size_t m = 0; m < stats.size(); ++m){
+		string method = escapeLabel(stats[m].method);
+		uint64_t coded = 0;
+		for(std::map<int, uint64_t>::const_iterator it = stats[m].errorCodes.begin();
+		    it != stats[m].errorCodes.end(); ++it){
+			out << "raptoreumapi_rpc_errors_total{method=\"" << method << "\",code=\"" << it->first << "\"} "
+			    << it->second << "\n";
+			coded += it->second;
+		}
+		if(stats[m].errors > coded){
+			out << "raptoreumapi_rpc_errors_total{method=\"" << method << "\",code=\"other\"} "
+			    << stats[m].errors - coded << "\n";
+		}
+	}
+
+	out << "# HELP raptoreumapi_rpc_request_bytes_total Bytes of RPC requests sent.\n"
+	    << "# TYPE raptoreumapi_rpc_request_bytes_total counter\n";
+	for(size_t m = 0; m < stats.size(); ++m){
+		out << "raptoreumapi_rpc_request_bytes_total{method=\"" << escapeLabel(stats[m].method) << "\"} "
+		    << stats[m].requestBytes << "\n";
+	}
+
+	out << "# HELP raptoreumapi_rpc_response_bytes_total Bytes of RPC responses received.\n"
+	    << "# TYPE raptoreumapi_rpc_response_bytes_total counter\n";
+	for(size_t m = 0; m < stats.size(); ++m){
+		out << "raptoreumapi_rpc_response_bytes_total{method=\"" << escapeLabel(stats[m].method) << "\"} "
+		    << stats[m].responseBytes << "\n";
+	}
+
+	out << "# HELP raptoreumapi_rpc_latency_seconds RPC round trip latency, a batch being one round trip.\n"
+	    << "# TYPE raptoreumapi_rpc_latency_seconds histogram\n";
+	for(size_t m = 0; m < stats.size(); ++m){
+		string method = escapeLabel(stats[m].method);
+		uint64_t cumulative = 0;
+		for(int i = 0; i <= LATENCY_BUCKETS; ++i){
+			cumulative += stats[m].latencyBuckets[i];
+			out << "raptoreumapi_rpc_latency_seconds_bucket{method=\"" << method << "\",le=\"";
+			if(i < LATENCY_BUCKETS){
+				out << LATENCY_BOUNDS[i] / 1e6;
+			}else{
+				out << "+Inf";
+			}
+			out << "\"} " << cumulative << "\n";
+		}
+		out << "raptoreumapi_rpc_latency_seconds_sum{method=\"" << method << "\"} "
+		    << std::fixed << std::setprecision(6) << stats[m].latencySum / 1e6 << "\n";
+		out.unsetf(std::ios_base::floatfield);
+		out << "raptoreumapi_rpc_latency_seconds_count{method=\"" << method << "\"} "
+		    << stats[m].roundTrips << "\n";
+	}
+
+	return out.str();
+}
@@ -0,0 +1,68 @@
+/**
+ * @file    rpcmetrics.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of the process wide registry of per method
+ * RPC metrics, filled in by RaptoreumAPI and read as stats
+ * or in Prometheus text format.
+ */
+
+#ifndef RAPTOREUM_API_RPCMETRICS_H
+#define RAPTOREUM_API_RPCMETRICS_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+struct rpcmethodstats_t{
+    std::string method;
+    uint64_t calls;                         // a batch counts each of its calls
+    uint64_t errors;
+    std::map<int, uint64_t> errorCodes;     // RaptoreumException code, count
+    uint64_t requestBytes;
+    uint64_t responseBytes;
+    uint64_t roundTrips;                    // a batch is one round trip
+    uint64_t latencySum;                    // microseconds, over all round trips
+    std::vector<uint64_t> latencyBuckets;   // round trips per RpcMetrics::LATENCY_BOUNDS entry, then above
+};
+
+/*
+ * Every thread records into counters of its own, which only it writes,
+ * so recording takes no lock and no atomic read-modify-write. Reading
+ * the stats sums the counters of all threads, including those that
+ * have exited. Counters only grow, as Prometheus expects.
+ */
+class RpcMetrics
+{
+
+public:
+    // Upper bounds of the latency buckets in microseconds
+    static const int LATENCY_BUCKETS = 16;
+    static const int64_t LATENCY_BOUNDS[LATENCY_BUCKETS];
+
+    // Methods beyond this many distinct names are counted as "other"
+    static const int MAX_METHODS = 256;
+    // Codes beyond this many distinct ones per method and thread only count in errors
+    static const int MAX_ERROR_CODES = 16;
+
+    // Recording is on by default
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // One round trip carrying calls calls of method
+    static void record(const std::string& method, unsigned int calls, int64_t latency,
+                       size_t requestBytes, size_t responseBytes);
+    // Failed calls of method
+    static void recordError(const std::string& method, int code, unsigned int calls = 1);
+
+    // Methods with at least one round trip, by name
+    static std::vector<rpcmethodstats_t> getStats();
+    // Stats in the Prometheus text exposition format
+    static std::string getPrometheusText();
+};
+
+
+#endif
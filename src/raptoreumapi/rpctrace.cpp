@@ -0,0 +1,22 @@
+/**
+ * @file    rpctrace.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of the tracing hook registration.
+ */
+
+#include "rpctrace.h"
+
+#include <atomic>
+
+static std::atomic<RpcTracer*> tracer(NULL);
+
+void RpcTracer::install(RpcTracer * t){
+	tracer.store(t, std::memory_order_release);
+}
+
+RpcTracer * RpcTracer::installed(){
+	return tracer.load(std::memory_order_acquire);
+}
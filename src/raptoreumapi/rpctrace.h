@@ -0,0 +1,59 @@
+/**
+ * @file    rpctrace.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of the tracing hook that receives one span
+ * per RPC round trip with the time spent in each phase.
+ */
+
+#ifndef RAPTOREUM_API_RPCTRACE_H
+#define RAPTOREUM_API_RPCTRACE_H
+
+#include <chrono>
+#include <string>
+#include <stdint.h>
+
+struct rpcspan_t{
+    std::string method;
+    unsigned int calls;                             // a batch is one span
+    int code;                                       // RaptoreumException code if the round trip failed, else 0
+    size_t requestBytes;
+    size_t responseBytes;
+    std::string request;                            // first RpcTracer::CAPTURE_BYTES of the request
+    std::string response;                           // and of the response, or of the transport error
+    std::chrono::steady_clock::time_point start;
+
+    // Phases in nanoseconds, adding up to total
+    int64_t serialize;                              // building the request
+    int64_t transport;                              // connecting, TLS, sending, the daemon and the response transfer
+    int64_t parse;                                  // reading the response, less decode
+    int64_t decode;                                 // typed decoding of scanned responses; calls returning a
+                                                    // Json::Value decode after the span has ended
+    int64_t total;
+};
+
+/*
+ * Installed once for the whole process. Without a tracer a call only
+ * tests a pointer; with one it reads the clock three more times, copies
+ * the head of both messages and builds the span.
+ */
+class RpcTracer
+{
+
+public:
+    static const size_t CAPTURE_BYTES = 256;
+
+    virtual ~RpcTracer() { }
+
+    // Called on the thread that made the call, once it is done; must not throw
+    virtual void onSpan(const rpcspan_t& span) = 0;
+
+    // NULL turns tracing off. The tracer has to outlive the calls in flight.
+    static void install(RpcTracer * tracer);
+    static RpcTracer * installed();
+};
+
+
+#endif
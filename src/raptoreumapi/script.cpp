@@ -0,0 +1,463 @@
+/**
+ * @file    script.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Local decoding of transaction scripts: disassembly,
+ * standard output types and Base58Check addresses.
+ */
+
+#include "script.h"
+#include "hash.h"
+#include "hex.h"
+
+#include <cstdio>
+#include <cstring>
+
+using std::string;
+using std::vector;
+
+
+const chainparams_t& MainNetParams(){
+	static const chainparams_t params = { 60, 16 };
+	return params;
+}
+
+const chainparams_t& TestNetParams(){
+	static const chainparams_t params = { 123, 19 };
+	return params;
+}
+
+/* === Base58Check === */
+
+static const char base58Digits[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+string EncodeBase58Check(const unsigned char * data, size_t len){
+	string ret;
+	EncodeBase58Check(data, len, ret);
+	return ret;
+}
+
+void EncodeBase58Check(const unsigned char * data, size_t len, string& out){
+	/* Addresses and keys fit on the stack, longer payloads go to the heap */
+	unsigned char inputBuf[72];
+	unsigned char b58Buf[100];
+	vector<unsigned char> inputHeap, b58Heap;
+	size_t inputLen = len + 4;
+	size_t b58Len = inputLen * 138 / 100 + 1;
+	unsigned char * input = inputBuf;
+	unsigned char * b58 = b58Buf;
+	if(inputLen > sizeof(inputBuf)){
+		inputHeap.resize(inputLen);
+		b58Heap.resize(b58Len);
+		input = &inputHeap[0];
+		b58 = &b58Heap[0];
+	}
+
+	std::memcpy(input, data, len);
+	unsigned char checksum[32];
+	DoubleSha256(data, len, checksum);
+	std::memcpy(input + len, checksum, 4);
+
+	/* Leading zero bytes map to '1' */
+	size_t zeros = 0;
+	while(zeros < inputLen && input[zeros] == 0){
+		++zeros;
+	}
+
+	/* Repeated division of the big endian number by 58, filled from the back */
+	b58Len = (inputLen - zeros) * 138 / 100 + 1;
+	std::memset(b58, 0, b58Len);
+	size_t length = 0;
+	for(size_t i = zeros; i < inputLen; ++i){
+		int carry = input[i];
+		size_t j = 0;
+		for(size_t k = b58Len; (carry != 0 || j < length) && k > 0; --k, ++j){
+			carry += 256 * b58[k - 1];
+			b58[k - 1] = carry % 58;
+			carry /= 58;
+		}
+		length = j;
+	}
+
+	out.assign(zeros, '1');
+	for(size_t k = b58Len - length; k < b58Len; ++k){
+		out += base58Digits[b58[k]];
+	}
+}
+
+bool DecodeBase58Check(const string& str, vector<unsigned char>& out){
+	size_t zeros = 0;
+	while(zeros < str.size() && str[zeros] == '1'){
+		++zeros;
+	}
+
+	vector<unsigned char> b256((str.size() - zeros) * 733 / 1000 + 1);
+	size_t length = 0;
+	for(size_t i = zeros; i < str.size(); ++i){
+		const char * digit = std::strchr(base58Digits, str[i]);
+		if(digit == NULL || str[i] == '\0'){
+			return false;
+		}
+		int carry = digit - base58Digits;
+		size_t j = 0;
+		for(vector<unsigned char>::reverse_iterator it = b256.rbegin(); (carry != 0 || j < length) && it != b256.rend(); ++it, ++j){
+			carry += 58 * (*it);
+			*it = carry % 256;
+			carry /= 256;
+		}
+		length = j;
+	}
+
+	out.assign(zeros, 0);
+	out.insert(out.end(), b256.end() - length, b256.end());
+	if(out.size() < 4){
+		return false;
+	}
+
+	unsigned char checksum[32];
+	DoubleSha256(&out[0], out.size() - 4, checksum);
+	if(std::memcmp(checksum, &out[out.size() - 4], 4) != 0){
+		return false;
+	}
+	out.resize(out.size() - 4);
+
+	return true;
+}
+
+/* === Scripts === */
+
+enum opcodetype{
+	OP_0 = 0x00,
+	OP_PUSHDATA1 = 0x4c,
+	OP_PUSHDATA2 = 0x4d,
+	OP_PUSHDATA4 = 0x4e,
+	OP_1NEGATE = 0x4f,
+	OP_1 = 0x51,
+	OP_16 = 0x60,
+	OP_RETURN = 0x6a,
+	OP_DUP = 0x76,
+	OP_EQUAL = 0x87,
+	OP_EQUALVERIFY = 0x88,
+	OP_HASH160 = 0xa9,
+	OP_CHECKSIG = 0xac,
+	OP_CHECKMULTISIG = 0xae
+};
+
+/* Filled once, thread safe as a function local static */
+struct opcodenames_t{
+	const char * names[256];
+
+	opcodenames_t(){
+		std::memset(names, 0, sizeof(names));
+		names[0x4f] = "-1"; names[0x50] = "OP_RESERVED";
+		names[0x61] = "OP_NOP"; names[0x62] = "OP_VER"; names[0x63] = "OP_IF"; names[0x64] = "OP_NOTIF";
+		names[0x65] = "OP_VERIF"; names[0x66] = "OP_VERNOTIF"; names[0x67] = "OP_ELSE"; names[0x68] = "OP_ENDIF";
+		names[0x69] = "OP_VERIFY"; names[0x6a] = "OP_RETURN"; names[0x6b] = "OP_TOALTSTACK"; names[0x6c] = "OP_FROMALTSTACK";
+		names[0x6d] = "OP_2DROP"; names[0x6e] = "OP_2DUP"; names[0x6f] = "OP_3DUP"; names[0x70] = "OP_2OVER";
+		names[0x71] = "OP_2ROT"; names[0x72] = "OP_2SWAP"; names[0x73] = "OP_IFDUP"; names[0x74] = "OP_DEPTH";
+		names[0x75] = "OP_DROP"; names[0x76] = "OP_DUP"; names[0x77] = "OP_NIP"; names[0x78] = "OP_OVER";
+		names[0x79] = "OP_PICK"; names[0x7a] = "OP_ROLL"; names[0x7b] = "OP_ROT"; names[0x7c] = "OP_SWAP";
+		names[0x7d] = "OP_TUCK"; names[0x7e] = "OP_CAT"; names[0x7f] = "OP_SUBSTR"; names[0x80] = "OP_LEFT";
+		names[0x81] = "OP_RIGHT"; names[0x82] = "OP_SIZE"; names[0x83] = "OP_INVERT"; names[0x84] = "OP_AND";
+		names[0x85] = "OP_OR"; names[0x86] = "OP_XOR"; names[0x87] = "OP_EQUAL"; names[0x88] = "OP_EQUALVERIFY";
+		names[0x89] = "OP_RESERVED1"; names[0x8a] = "OP_RESERVED2"; names[0x8b] = "OP_1ADD"; names[0x8c] = "OP_1SUB";
+		names[0x8d] = "OP_2MUL"; names[0x8e] = "OP_2DIV"; names[0x8f] = "OP_NEGATE"; names[0x90] = "OP_ABS";
+		names[0x91] = "OP_NOT"; names[0x92] = "OP_0NOTEQUAL"; names[0x93] = "OP_ADD"; names[0x94] = "OP_SUB";
+		names[0x95] = "OP_MUL"; names[0x96] = "OP_DIV"; names[0x97] = "OP_MOD"; names[0x98] = "OP_LSHIFT";
+		names[0x99] = "OP_RSHIFT"; names[0x9a] = "OP_BOOLAND"; names[0x9b] = "OP_BOOLOR"; names[0x9c] = "OP_NUMEQUAL";
+		names[0x9d] = "OP_NUMEQUALVERIFY"; names[0x9e] = "OP_NUMNOTEQUAL"; names[0x9f] = "OP_LESSTHAN";
+		names[0xa0] = "OP_GREATERTHAN"; names[0xa1] = "OP_LESSTHANOREQUAL"; names[0xa2] = "OP_GREATERTHANOREQUAL";
+		names[0xa3] = "OP_MIN"; names[0xa4] = "OP_MAX"; names[0xa5] = "OP_WITHIN"; names[0xa6] = "OP_RIPEMD160";
+		names[0xa7] = "OP_SHA1"; names[0xa8] = "OP_SHA256"; names[0xa9] = "OP_HASH160"; names[0xaa] = "OP_HASH256";
+		names[0xab] = "OP_CODESEPARATOR"; names[0xac] = "OP_CHECKSIG"; names[0xad] = "OP_CHECKSIGVERIFY";
+		names[0xae] = "OP_CHECKMULTISIG"; names[0xaf] = "OP_CHECKMULTISIGVERIFY"; names[0xb0] = "OP_NOP1";
+		names[0xb1] = "OP_CHECKLOCKTIMEVERIFY"; names[0xb2] = "OP_CHECKSEQUENCEVERIFY"; names[0xb3] = "OP_NOP4";
+		names[0xb4] = "OP_NOP5"; names[0xb5] = "OP_NOP6"; names[0xb6] = "OP_NOP7"; names[0xb7] = "OP_NOP8";
+		names[0xb8] = "OP_NOP9"; names[0xb9] = "OP_NOP10"; names[0xff] = "OP_INVALIDOPCODE";
+	}
+};
+
+static const char * opcodeName(unsigned char op){
+	static const opcodenames_t table;
+	return table.names[op] != NULL ? table.names[op] : "OP_UNKNOWN";
+}
+
+/* Reads the opcode at pc and its push data, false on a truncated push */
+static bool getOp(const unsigned char *& pc, const unsigned char * end, unsigned char& op,
+                  const unsigned char *& data, size_t& size){
+	data = NULL;
+	size = 0;
+	if(pc >= end){
+		return false;
+	}
+
+	op = *pc++;
+	if(op > OP_PUSHDATA4){
+		return true;
+	}
+
+	if(op < OP_PUSHDATA1){
+		size = op;
+	}else{
+		size_t width = (op == OP_PUSHDATA1) ? 1 : (op == OP_PUSHDATA2) ? 2 : 4;
+		if((size_t) (end - pc) < width){
+			return false;
+		}
+		for(size_t i = 0; i < width; ++i){
+			size |= (size_t) pc[i] << (8 * i);
+		}
+		pc += width;
+	}
+
+	if((size_t) (end - pc) < size){
+		return false;
+	}
+	data = pc;
+	pc += size;
+
+	return true;
+}
+
+/* Strict DER signature encoding (BIP66) followed by a hash type byte */
+static bool isValidSignatureEncoding(const unsigned char * sig, size_t size){
+	if(size < 9 || size > 73) return false;
+	if(sig[0] != 0x30) return false;
+	if(sig[1] != size - 3) return false;
+
+	size_t lenR = sig[3];
+	if(5 + lenR >= size) return false;
+	size_t lenS = sig[5 + lenR];
+	if(lenR + lenS + 7 != size) return false;
+
+	if(sig[2] != 0x02 || lenR == 0 || (sig[4] & 0x80)) return false;
+	if(lenR > 1 && sig[4] == 0x00 && !(sig[5] & 0x80)) return false;
+
+	if(sig[lenR + 4] != 0x02 || lenS == 0 || (sig[lenR + 6] & 0x80)) return false;
+	if(lenS > 1 && sig[lenR + 6] == 0x00 && !(sig[lenR + 7] & 0x80)) return false;
+
+	return true;
+}
+
+static const char * sighashName(unsigned char type){
+	switch(type){
+	case 0x01: return "ALL";
+	case 0x02: return "NONE";
+	case 0x03: return "SINGLE";
+	case 0x81: return "ALL|ANYONECANPAY";
+	case 0x82: return "NONE|ANYONECANPAY";
+	case 0x83: return "SINGLE|ANYONECANPAY";
+	default: return NULL;
+	}
+}
+
+string ScriptToAsm(const unsigned char * script, size_t len, bool sighashDecode){
+	string ret;
+	ScriptToAsm(script, len, ret, sighashDecode);
+	return ret;
+}
+
+void ScriptToAsm(const unsigned char * script, size_t len, string& ret, bool sighashDecode){
+	ret.clear();
+	const unsigned char * pc = script;
+	const unsigned char * end = script + len;
+	bool unspendable = (len > 0 && script[0] == OP_RETURN);
+
+	while(pc < end){
+		if(!ret.empty()){
+			ret += ' ';
+		}
+
+		unsigned char op;
+		const unsigned char * data;
+		size_t size;
+		if(!getOp(pc, end, op, data, size)){
+			ret += "[error]";
+			break;
+		}
+
+		if(op > OP_PUSHDATA4){
+			if(op >= OP_1 && op <= OP_16){
+				char num[4];
+				std::snprintf(num, sizeof(num), "%d", op - OP_1 + 1);
+				ret += num;
+			}else{
+				ret += opcodeName(op);
+			}
+			continue;
+		}
+
+		/* Short pushes read as script numbers, little endian with sign bit */
+		if(size <= 4){
+			int64_t num = 0;
+			for(size_t i = 0; i < size; ++i){
+				num |= (int64_t) data[i] << (8 * i);
+			}
+			if(size > 0 && (data[size - 1] & 0x80)){
+				num = -(num & ~((int64_t) 0x80 << (8 * (size - 1))));
+			}
+			char buf[24];
+			std::snprintf(buf, sizeof(buf), "%lld", (long long) num);
+			ret += buf;
+			continue;
+		}
+
+		const char * hashtype = NULL;
+		if(sighashDecode && !unspendable && isValidSignatureEncoding(data, size)){
+			hashtype = sighashName(data[size - 1]);
+		}
+		/* Hex appended in place rather than through a temporary */
+		size_t hexLen = (hashtype != NULL) ? size - 1 : size;
+		size_t at = ret.size();
+		ret.resize(at + 2 * hexLen);
+		HexEncode(data, hexLen, &ret[at]);
+		if(hashtype != NULL){
+			ret += '[';
+			ret += hashtype;
+			ret += ']';
+		}
+	}
+}
+
+static void hashAddress(unsigned char prefix, const unsigned char * hash, string& out){
+	unsigned char payload[21];
+	payload[0] = prefix;
+	std::memcpy(payload + 1, hash, 20);
+	EncodeBase58Check(payload, sizeof(payload), out);
+}
+
+static void pubkeyAddress(unsigned char prefix, const unsigned char * pubkey, size_t size, string& out){
+	unsigned char hash[20];
+	Hash160(pubkey, size, hash);
+	hashAddress(prefix, hash, out);
+}
+
+static bool isPubKey(const unsigned char * data, size_t size){
+	return (size == 33 && (data[0] == 0x02 || data[0] == 0x03))
+	       || (size == 65 && data[0] == 0x04);
+}
+
+void DecodeScriptPubKey(const unsigned char * script, size_t len, scriptPubKey_t& ret,
+                        const chainparams_t& params){
+	ScriptToAsm(script, len, ret.assm);
+	HexStr(script, len, ret.hex);
+	ret.reqSigs = 0;
+
+	/* Pay to public key hash */
+	if(len == 25 && script[0] == OP_DUP && script[1] == OP_HASH160 && script[2] == 20
+	   && script[23] == OP_EQUALVERIFY && script[24] == OP_CHECKSIG){
+		ret.type = "pubkeyhash";
+		ret.reqSigs = 1;
+		ret.addresses.resize(1);
+		hashAddress(params.pubkeyPrefix, script + 3, ret.addresses[0]);
+		return;
+	}
+
+	/* Pay to script hash */
+	if(len == 23 && script[0] == OP_HASH160 && script[1] == 20 && script[22] == OP_EQUAL){
+		ret.type = "scripthash";
+		ret.reqSigs = 1;
+		ret.addresses.resize(1);
+		hashAddress(params.scriptPrefix, script + 2, ret.addresses[0]);
+		return;
+	}
+
+	/* Pay to public key */
+	if((len == 35 || len == 67) && script[0] == len - 2 && script[len - 1] == OP_CHECKSIG
+	   && isPubKey(script + 1, len - 2)){
+		ret.type = "pubkey";
+		ret.reqSigs = 1;
+		ret.addresses.resize(1);
+		pubkeyAddress(params.pubkeyPrefix, script + 1, len - 2, ret.addresses[0]);
+		return;
+	}
+
+	/* No address from here on, except for bare multisig */
+	ret.addresses.clear();
+
+	if(len > 0 && script[0] == OP_RETURN){
+		ret.type = "nulldata";
+		return;
+	}
+
+	/* Bare multisig: OP_m <pubkey>... OP_n OP_CHECKMULTISIG */
+	if(len >= 3 && script[len - 1] == OP_CHECKMULTISIG
+	   && script[0] >= OP_1 && script[0] <= OP_16 && script[len - 2] >= OP_1 && script[len - 2] <= OP_16){
+		int required = script[0] - OP_1 + 1;
+		int keys = script[len - 2] - OP_1 + 1;
+		vector<string> addresses;
+		const unsigned char * pc = script + 1;
+		const unsigned char * end = script + len - 2;
+
+		while(pc < end){
+			unsigned char op;
+			const unsigned char * data;
+			size_t size;
+			if(!getOp(pc, end, op, data, size) || op > OP_PUSHDATA4 || !isPubKey(data, size)){
+				break;
+			}
+			addresses.push_back(string());
+			pubkeyAddress(params.pubkeyPrefix, data, size, addresses.back());
+		}
+
+		if(pc == end && (int) addresses.size() == keys && required <= keys){
+			ret.type = "multisig";
+			ret.reqSigs = required;
+			ret.addresses.swap(addresses);
+			return;
+		}
+	}
+
+	ret.type = "nonstandard";
+}
+
+bool AddressToScript(const string& address, vector<unsigned char>& script, const chainparams_t& params){
+	vector<unsigned char> decoded;
+	if(!DecodeBase58Check(address, decoded) || decoded.size() != 21){
+		return false;
+	}
+
+	script.clear();
+	if(decoded[0] == params.pubkeyPrefix){
+		script.push_back(OP_DUP);
+		script.push_back(OP_HASH160);
+		script.push_back(20);
+		script.insert(script.end(), decoded.begin() + 1, decoded.end());
+		script.push_back(OP_EQUALVERIFY);
+		script.push_back(OP_CHECKSIG);
+		return true;
+	}
+	if(decoded[0] == params.scriptPrefix){
+		script.push_back(OP_HASH160);
+		script.push_back(20);
+		script.insert(script.end(), decoded.begin() + 1, decoded.end());
+		script.push_back(OP_EQUAL);
+		return true;
+	}
+
+	return false;
+}
+
+void DataToScript(const unsigned char * data, size_t len, vector<unsigned char>& script){
+	script.clear();
+	script.push_back(OP_RETURN);
+
+	/* Smallest push that fits */
+	if(len < OP_PUSHDATA1){
+		script.push_back((unsigned char) len);
+	}else if(len <= 0xff){
+		script.push_back(OP_PUSHDATA1);
+		script.push_back((unsigned char) len);
+	}else if(len <= 0xffff){
+		script.push_back(OP_PUSHDATA2);
+		script.push_back((unsigned char) len);
+		script.push_back((unsigned char) (len >> 8));
+	}else{
+		script.push_back(OP_PUSHDATA4);
+		for(int i = 0; i < 4; ++i){
+			script.push_back((unsigned char) (len >> (8 * i)));
+		}
+	}
+	script.insert(script.end(), data, data + len);
+}
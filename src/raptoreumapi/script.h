@@ -0,0 +1,55 @@
+/**
+ * @file    script.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Local decoding of transaction scripts: disassembly,
+ * standard output types and Base58Check addresses.
+ */
+
+#ifndef RAPTOREUM_API_SCRIPT_H
+#define RAPTOREUM_API_SCRIPT_H
+
+#include "types.h"
+
+#include <stddef.h>
+
+/* Address version bytes of a network */
+struct chainparams_t{
+	unsigned char pubkeyPrefix;
+	unsigned char scriptPrefix;
+};
+
+const chainparams_t& MainNetParams();
+const chainparams_t& TestNetParams();
+
+/* === Base58Check === */
+
+std::string EncodeBase58Check(const unsigned char * data, size_t len);
+void EncodeBase58Check(const unsigned char * data, size_t len, std::string& out);
+// False on invalid characters or a wrong checksum
+bool DecodeBase58Check(const std::string& str, std::vector<unsigned char>& out);
+
+/* === Scripts === */
+
+// Disassembly as in the daemon's "asm" fields; sighashDecode turns the
+// hash type of signatures into a suffix such as [ALL], as for scriptSig
+std::string ScriptToAsm(const unsigned char * script, size_t len, bool sighashDecode = false);
+void ScriptToAsm(const unsigned char * script, size_t len, std::string& out, bool sighashDecode = false);
+
+// Fills type, reqSigs and addresses of a scriptPubKey (asm and hex included),
+// reusing the capacity of the strings already in ret
+void DecodeScriptPubKey(const unsigned char * script, size_t len, scriptPubKey_t& ret,
+                        const chainparams_t& params = MainNetParams());
+
+// scriptPubKey paying to a pubkey hash or script hash address. False if
+// the address is not valid for params.
+bool AddressToScript(const std::string& address, std::vector<unsigned char>& script,
+                     const chainparams_t& params = MainNetParams());
+
+// OP_RETURN output script carrying data
+void DataToScript(const unsigned char * data, size_t len, std::vector<unsigned char>& script);
+
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file    serialize.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Reading and writing of the daemon's binary serialization
+ * format (little endian integers, CompactSize lengths).
+ */
+
+#ifndef RAPTOREUM_API_SERIALIZE_H
+#define RAPTOREUM_API_SERIALIZE_H
+
+#include "exception.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+class ByteReader
+{
+
+private:
+    const unsigned char * pos;
+    const unsigned char * end;
+
+public:
+    ByteReader(const unsigned char * data, size_t len)
+    : pos(data), end(data + len) { }
+
+    const unsigned char * position() const { return pos; }
+    size_t remaining() const { return end - pos; }
+
+    // Returns the current position and skips len bytes
+    const unsigned char * read(size_t len){
+        if(remaining() < len){
+            throw RaptoreumException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE,
+                                     "Invalid serialization: unexpected end of data");
+        }
+        const unsigned char * ret = pos;
+        pos += len;
+        return ret;
+    }
+
+    uint8_t readUInt8(){
+        return *read(1);
+    }
+
+    uint16_t readUInt16(){
+        const unsigned char * p = read(2);
+        return (uint16_t) (p[0] | (p[1] << 8));
+    }
+
+    uint32_t readUInt32(){
+        const unsigned char * p = read(4);
+        return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+    }
+
+    uint64_t readUInt64(){
+        uint64_t lo = readUInt32();
+        return lo | ((uint64_t) readUInt32() << 32);
+    }
+
+    uint64_t readCompactSize(){
+        uint8_t first = readUInt8();
+        if(first < 253) return first;
+        if(first == 253) return readUInt16();
+        if(first == 254) return readUInt32();
+        return readUInt64();
+    }
+
+    // Length prefixed byte string, returns its start and stores its length
+    const unsigned char * readBytes(size_t& len){
+        uint64_t size = readCompactSize();
+        if(size > remaining()){
+            throw RaptoreumException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE,
+                                     "Invalid serialization: length exceeds data");
+        }
+        len = (size_t) size;
+        return read(len);
+    }
+};
+
+class ByteWriter
+{
+
+private:
+    std::vector<unsigned char>& out;
+
+public:
+    // Appends to out
+    explicit ByteWriter(std::vector<unsigned char>& out)
+    : out(out) { }
+
+    void write(const unsigned char * data, size_t len){
+        out.insert(out.end(), data, data + len);
+    }
+
+    void writeUInt8(uint8_t x){
+        out.push_back(x);
+    }
+
+    void writeUInt16(uint16_t x){
+        out.push_back((unsigned char) x);
+        out.push_back((unsigned char) (x >> 8));
+    }
+
+    void writeUInt32(uint32_t x){
+        for(int i = 0; i < 4; ++i){
+            out.push_back((unsigned char) (x >> (8 * i)));
+        }
+    }
+
+    void writeUInt64(uint64_t x){
+        writeUInt32((uint32_t) x);
+        writeUInt32((uint32_t) (x >> 32));
+    }
+
+    void writeCompactSize(uint64_t x){
+        if(x < 253){
+            writeUInt8((uint8_t) x);
+        }else if(x <= 0xffff){
+            writeUInt8(253);
+            writeUInt16((uint16_t) x);
+        }else if(x <= 0xffffffff){
+            writeUInt8(254);
+            writeUInt32((uint32_t) x);
+        }else{
+            writeUInt8(255);
+            writeUInt64(x);
+        }
+    }
+
+    void writeBytes(const unsigned char * data, size_t len){
+        writeCompactSize(len);
+        write(data, len);
+    }
+
+    static size_t compactSizeLength(uint64_t x){
+        return x < 253 ? 1 : x <= 0xffff ? 3 : x <= 0xffffffff ? 5 : 9;
+    }
+};
+
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file    slowcalllog.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of a tracer that keeps the last slow
+ * RPC round trips.
+ */
+
+#include "slowcalllog.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <sstream>
+
+using std::string;
+using std::vector;
+
+/* The params of a single call request, else the request as sent, on one line */
+static string summary(const string& request, bool complete){
+	string ret = request;
+	size_t params = ret.find("\"params\":");
+
+	if(ret.compare(0, 1, "{") == 0 && params != string::npos){
+		ret.erase(0, params + 9);
+		if(complete){
+			size_t end = ret.find_last_of('}');
+			if(end != string::npos){
+				ret.erase(end);
+			}
+		}
+	}
+	while(!ret.empty() && (ret[ret.size() - 1] == '\n' || ret[ret.size() - 1] == '\r')){
+		ret.erase(ret.size() - 1);
+	}
+	for(size_t i = 0; i < ret.size(); ++i){
+		if(ret[i] == '\n' || ret[i] == '\r'){
+			ret[i] = ' ';
+		}
+	}
+	if(!complete){
+		ret += "...";
+	}
+	return ret;
+}
+
+SlowCallLog::SlowCallLog(size_t capacity, int64_t defaultThreshold, RpcTracer * next)
+: defaultThreshold(defaultThreshold),
+  next(next),
+  capacity(std::max(capacity, (size_t) 1)),
+  first(0),
+  slowCalls(0)
+{
+	ring.reserve(this->capacity);
+}
+
+void SlowCallLog::setThreshold(const string& method, int64_t threshold){
+	thresholds[method] = threshold;
+}
+
+void SlowCallLog::onSpan(const rpcspan_t& span){
+	std::map<string, int64_t>::const_iterator it = thresholds.find(span.method);
+	int64_t threshold = (it != thresholds.end()) ? it->second : defaultThreshold;
+
+	if(threshold > 0 && span.total >= threshold * 1000){
+		slowcall_t call;
+		call.time = std::chrono::system_clock::now() -
+		            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(span.total));
+		call.span = span;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if(ring.size() < capacity){
+			ring.push_back(call);
+		}else{
+			ring[first] = call;
+			first = (first + 1) % capacity;
+		}
+		++slowCalls;
+	}
+
+	if(next != NULL){
+		next->onSpan(span);
+	}
+}
+
+uint64_t SlowCallLog::getSlowCount() const{
+	return slowCalls;
+}
+
+vector<slowcall_t> SlowCallLog::getCalls() const{
+	std::lock_guard<std::mutex> lock(mutex);
+	vector<slowcall_t> ret(ring.begin() + first, ring.end());
+	ret.insert(ret.end(), ring.begin(), ring.begin() + first);
+	return ret;
+}
+
+string SlowCallLog::dump() const{
+	vector<slowcall_t> calls = getCalls();
+	std::ostringstream out;
+
+	for(size_t i = 0; i < calls.size(); ++i){
+		const rpcspan_t& span = calls[i].span;
+
+		std::time_t seconds = std::chrono::system_clock::to_time_t(calls[i].time);
+		long millis = (long) (std::chrono::duration_cast<std::chrono::milliseconds>(
+			calls[i].time.time_since_epoch()).count() % 1000);
+		struct tm utc;
+		gmtime_r(&seconds, &utc);
+		char date[24];
+		char time[32];
+		std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", &utc);
+		std::snprintf(time, sizeof(time), "%s.%03ldZ", date, millis);
+		char phases[160];
+		std::snprintf(phases, sizeof(phases),
+		              "%.3f ms (serialize %.3f, transport %.3f, parse %.3f, decode %.3f)",
+		              span.total / 1e6, span.serialize / 1e6, span.transport / 1e6, span.parse / 1e6,
+		              span.decode / 1e6);
+
+		out << time << " " << span.method << " " << phases
+		    << " calls " << span.calls << ", code " << span.code
+		    << ", request " << span.requestBytes << " B, response " << span.responseBytes << " B"
+		    << ", params " << summary(span.request, span.requestBytes <= span.request.size())
+		    << ", response " << summary(span.response, span.response.size() < RpcTracer::CAPTURE_BYTES)
+		    << "\n";
+	}
+
+	return out.str();
+}
+
+void SlowCallLog::clear(){
+	std::lock_guard<std::mutex> lock(mutex);
+	ring.clear();
+	first = 0;
+}
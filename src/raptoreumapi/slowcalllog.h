@@ -0,0 +1,72 @@
+/**
+ * @file    slowcalllog.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of a tracer that keeps the last slow RPC
+ * round trips, with their phases and the head of their
+ * request and response, for dumping on demand.
+ */
+
+#ifndef RAPTOREUM_API_SLOWCALLLOG_H
+#define RAPTOREUM_API_SLOWCALLLOG_H
+
+#include "rpctrace.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct slowcall_t{
+    std::chrono::system_clock::time_point time;     // when the call was sent
+    rpcspan_t span;
+};
+
+/*
+ * A round trip is slow when its total time reaches the threshold of its
+ * method, or the default one. Calls below it only cost a map lookup.
+ * The log keeps the last capacity slow calls; set the thresholds before
+ * installing it, e.g.
+ *
+ *   SlowCallLog log(100, 500000);
+ *   log.setThreshold("getaddresstxids", 250000);
+ *   RpcTracer::install(&log);
+ */
+class SlowCallLog : public RpcTracer
+{
+
+private:
+    int64_t defaultThreshold;
+    std::map<std::string, int64_t> thresholds;
+    RpcTracer * next;
+
+    mutable std::mutex mutex;                       // guards the ring
+    std::vector<slowcall_t> ring;
+    size_t capacity;
+    size_t first;                                   // oldest entry once the ring is full
+    std::atomic<uint64_t> slowCalls;
+
+public:
+    // Thresholds in microseconds, 0 for none. Every span is passed on to next, if given.
+    explicit SlowCallLog(size_t capacity = 256, int64_t defaultThreshold = 1000000, RpcTracer * next = NULL);
+
+    // Not while installed
+    void setThreshold(const std::string& method, int64_t threshold);
+
+    void onSpan(const rpcspan_t& span);
+
+    // Slow calls seen, including those the ring has dropped since
+    uint64_t getSlowCount() const;
+    // Oldest first
+    std::vector<slowcall_t> getCalls() const;
+    // One line per call, oldest first
+    std::string dump() const;
+    void clear();
+};
+
+
+#endif
@@ -0,0 +1,137 @@
+/**
+ * @file    transaction.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Local decoding of serialized Raptoreum transactions.
+ */
+
+#include "transaction.h"
+#include "serialize.h"
+#include "hash.h"
+#include "hex.h"
+
+#include <cstring>
+
+using jsonrpc::Errors;
+
+using std::string;
+using std::vector;
+
+
+size_t DecodeTransaction(const unsigned char * data, size_t len, decoderawtransaction_t& ret,
+                         const chainparams_t& params, bool hashTxid){
+	static const unsigned char nullHash[32] = { 0 };
+	ByteReader reader(data, len);
+	size_t size;
+
+	/* 16 bit version, special transaction type in the upper half */
+	uint32_t version = reader.readUInt32();
+	ret.version = version & 0xFFFF;
+	ret.type = version >> 16;
+
+	/* Vectors are resized rather than rebuilt to keep their capacity. An
+	   input takes at least 41 bytes and an output 9, which bounds the
+	   counts before anything is allocated for them. */
+	uint64_t count = reader.readCompactSize();
+	if(count > reader.remaining() / 41){
+		throw RaptoreumException(Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid transaction: input count exceeds data");
+	}
+	ret.vin.resize(count);
+	for(size_t i = 0; i < ret.vin.size(); ++i){
+		vin_t& input = ret.vin[i];
+		const unsigned char * prevout = reader.read(32);
+		input.n = reader.readUInt32();
+		const unsigned char * script = reader.readBytes(size);
+		input.sequence = reader.readUInt32();
+
+		if(input.n == 0xFFFFFFFF && std::memcmp(prevout, nullHash, 32) == 0){
+			HexStr(script, size, input.coinbase);
+			input.txid.clear();
+			input.scriptSig.assm.clear();
+			input.scriptSig.hex.clear();
+		}else{
+			input.coinbase.clear();
+			HexStr(prevout, 32, input.txid, true);
+			ScriptToAsm(script, size, input.scriptSig.assm, true);
+			HexStr(script, size, input.scriptSig.hex);
+		}
+	}
+
+	count = reader.readCompactSize();
+	if(count > reader.remaining() / 9){
+		throw RaptoreumException(Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid transaction: output count exceeds data");
+	}
+	ret.vout.resize(count);
+	for(size_t i = 0; i < ret.vout.size(); ++i){
+		vout_t& output = ret.vout[i];
+		output.valueSat = (int64_t) reader.readUInt64();
+		output.value = output.valueSat / 100000000.0;
+		output.n = i;
+		const unsigned char * script = reader.readBytes(size);
+		DecodeScriptPubKey(script, size, output.scriptPubKey, params);
+	}
+
+	ret.locktime = reader.readUInt32();
+
+	if(ret.version >= 3 && ret.type != TRANSACTION_NORMAL){
+		const unsigned char * payload = reader.readBytes(size);
+		HexStr(payload, size, ret.extraPayload);
+	}else{
+		ret.extraPayload.clear();
+	}
+
+	ret.size = reader.position() - data;
+
+	if(hashTxid){
+		unsigned char hash[32];
+		DoubleSha256(data, ret.size, hash);
+		HexStr(hash, sizeof(hash), ret.txid, true);
+	}else{
+		ret.txid.clear();
+	}
+
+	return ret.size;
+}
+
+size_t TransactionSize(const unsigned char * data, size_t len){
+	ByteReader reader(data, len);
+	size_t size;
+
+	uint32_t version = reader.readUInt32();
+
+	for(uint64_t n = reader.readCompactSize(); n > 0; --n){
+		reader.read(36);
+		reader.readBytes(size);
+		reader.read(4);
+	}
+	for(uint64_t n = reader.readCompactSize(); n > 0; --n){
+		reader.read(8);
+		reader.readBytes(size);
+	}
+	reader.read(4);
+
+	if((version & 0xFFFF) >= 3 && (version >> 16) != TRANSACTION_NORMAL){
+		reader.readBytes(size);
+	}
+
+	return reader.position() - data;
+}
+
+void DecodeRawTransaction(const string& hex, getrawtransaction_t& ret, const chainparams_t& params){
+	/* Kept per thread, so decoding in a loop does not allocate for the bytes */
+	static thread_local vector<unsigned char> data;
+	if(!HexToBytes(hex, data) || data.empty()){
+		throw RaptoreumException(Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid transaction: not a hex string");
+	}
+
+	size_t size = DecodeTransaction(&data[0], data.size(), ret, params);
+	if(size != data.size()){
+		throw RaptoreumException(Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid transaction: trailing data");
+	}
+
+	if(&ret.hex != &hex){
+		ret.hex = hex;
+	}
+}
@@ -0,0 +1,51 @@
+/**
+ * @file    transaction.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Local decoding of serialized Raptoreum transactions, so
+ * getrawtransaction can be called with verbose=0 and the
+ * daemon does not have to produce the JSON form.
+ */
+
+#ifndef RAPTOREUM_API_TRANSACTION_H
+#define RAPTOREUM_API_TRANSACTION_H
+
+#include "types.h"
+#include "exception.h"
+#include "script.h"
+
+/* Special transaction types, carried in the upper 16 bits of the version */
+enum txtype{
+	TRANSACTION_NORMAL = 0,
+	TRANSACTION_PROVIDER_REGISTER = 1,
+	TRANSACTION_PROVIDER_UPDATE_SERVICE = 2,
+	TRANSACTION_PROVIDER_UPDATE_REGISTRAR = 3,
+	TRANSACTION_PROVIDER_UPDATE_REVOKE = 4,
+	TRANSACTION_COINBASE = 5,
+	TRANSACTION_QUORUM_COMMITMENT = 6,
+	TRANSACTION_FUTURE = 7,
+	TRANSACTION_NEW_ASSET = 8,
+	TRANSACTION_UPDATE_ASSET = 9,
+	TRANSACTION_MINT_ASSET = 10
+};
+
+// Decodes the transaction at the start of data into ret and returns its
+// size in bytes. Throws a RaptoreumException on malformed data. With
+// hashTxid false the txid is left empty, for callers that hash many
+// transactions at once with DoubleSha256Batch.
+size_t DecodeTransaction(const unsigned char * data, size_t len, decoderawtransaction_t& ret,
+                         const chainparams_t& params = MainNetParams(), bool hashTxid = true);
+
+// Size in bytes of the transaction at the start of data, found by reading
+// only the length fields. Throws a RaptoreumException on truncated data.
+size_t TransactionSize(const unsigned char * data, size_t len);
+
+// Same for a hex encoded transaction, ret.hex is set to hex. The block
+// fields (blockhash, confirmations, time, blocktime) are left untouched.
+void DecodeRawTransaction(const std::string& hex, getrawtransaction_t& ret,
+                          const chainparams_t& params = MainNetParams());
+
+
+#endif
@@ -0,0 +1,164 @@
+/**
+ * @file    txbuilder.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of an offline transaction builder.
+ */
+
+#include "txbuilder.h"
+#include "exception.h"
+#include "transaction.h"
+#include "serialize.h"
+#include "hex.h"
+
+using std::string;
+using std::vector;
+
+
+TransactionBuilder::TransactionBuilder(const chainparams_t& params)
+: params(params),
+  version(1),
+  type(TRANSACTION_NORMAL),
+  locktime(0)
+{
+}
+
+TransactionBuilder& TransactionBuilder::setVersion(int version){
+	this->version = version;
+	return *this;
+}
+
+TransactionBuilder& TransactionBuilder::setType(int type){
+	this->type = type;
+	return *this;
+}
+
+TransactionBuilder& TransactionBuilder::setLockTime(uint32_t locktime){
+	this->locktime = locktime;
+	return *this;
+}
+
+TransactionBuilder& TransactionBuilder::setExtraPayload(const string& hex){
+	if(!HexToBytes(hex, extraPayload)){
+		throw RaptoreumException(RPC_INVALID_PARAMETER, "Invalid extra payload");
+	}
+	return *this;
+}
+
+TransactionBuilder& TransactionBuilder::addInput(const string& txid, unsigned int n, uint32_t sequence){
+	input_t input;
+	if(!ParseHash(txid, input.hash)){
+		throw RaptoreumException(RPC_INVALID_PARAMETER, "Invalid txid " + txid);
+	}
+	input.n = n;
+	input.sequence = sequence;
+	inputs.push_back(input);
+	return *this;
+}
+
+TransactionBuilder& TransactionBuilder::addInput(const txout_t& outpoint, uint32_t sequence){
+	return addInput(outpoint.txid, outpoint.n, sequence);
+}
+
+TransactionBuilder& TransactionBuilder::addOutput(const string& address, int64_t satoshis){
+	output_t output;
+	if(!AddressToScript(address, output.script, params)){
+		throw RaptoreumException(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address " + address);
+	}
+	output.satoshis = satoshis;
+	outputs.push_back(output);
+	return *this;
+}
+
+TransactionBuilder& TransactionBuilder::addOutput(const vector<unsigned char>& script, int64_t satoshis){
+	output_t output;
+	output.satoshis = satoshis;
+	output.script = script;
+	outputs.push_back(output);
+	return *this;
+}
+
+TransactionBuilder& TransactionBuilder::addData(const vector<unsigned char>& data){
+	output_t output;
+	output.satoshis = 0;
+	DataToScript(data.empty() ? NULL : &data[0], data.size(), output.script);
+	outputs.push_back(output);
+	return *this;
+}
+
+void TransactionBuilder::clear(){
+	inputs.clear();
+	outputs.clear();
+	extraPayload.clear();
+}
+
+size_t TransactionBuilder::inputCount() const{
+	return inputs.size();
+}
+
+size_t TransactionBuilder::outputCount() const{
+	return outputs.size();
+}
+
+int64_t TransactionBuilder::outputValue() const{
+	int64_t ret = 0;
+	for(size_t i = 0; i < outputs.size(); ++i){
+		ret += outputs[i].satoshis;
+	}
+	return ret;
+}
+
+size_t TransactionBuilder::size() const{
+	/* version, locktime and the counts */
+	size_t ret = 8 + ByteWriter::compactSizeLength(inputs.size()) + ByteWriter::compactSizeLength(outputs.size());
+
+	/* outpoint, empty scriptSig and sequence */
+	ret += inputs.size() * (36 + 1 + 4);
+	for(size_t i = 0; i < outputs.size(); ++i){
+		ret += 8 + ByteWriter::compactSizeLength(outputs[i].script.size()) + outputs[i].script.size();
+	}
+	if(version >= 3 && type != TRANSACTION_NORMAL){
+		ret += ByteWriter::compactSizeLength(extraPayload.size()) + extraPayload.size();
+	}
+
+	return ret;
+}
+
+size_t TransactionBuilder::signedSize() const{
+	return size() + inputs.size() * (P2PKH_INPUT_SIZE - 41);
+}
+
+void TransactionBuilder::serialize(vector<unsigned char>& out) const{
+	ByteWriter writer(out);
+	out.reserve(out.size() + size());
+
+	writer.writeUInt32((uint32_t) (version & 0xFFFF) | ((uint32_t) type << 16));
+
+	writer.writeCompactSize(inputs.size());
+	for(size_t i = 0; i < inputs.size(); ++i){
+		writer.write(inputs[i].hash, 32);
+		writer.writeUInt32(inputs[i].n);
+		writer.writeCompactSize(0);
+		writer.writeUInt32(inputs[i].sequence);
+	}
+
+	writer.writeCompactSize(outputs.size());
+	for(size_t i = 0; i < outputs.size(); ++i){
+		writer.writeUInt64((uint64_t) outputs[i].satoshis);
+		writer.writeBytes(outputs[i].script.empty() ? NULL : &outputs[i].script[0], outputs[i].script.size());
+	}
+
+	writer.writeUInt32(locktime);
+
+	if(version >= 3 && type != TRANSACTION_NORMAL){
+		writer.writeBytes(extraPayload.empty() ? NULL : &extraPayload[0], extraPayload.size());
+	}
+}
+
+string TransactionBuilder::toHex() const{
+	vector<unsigned char> data;
+	serialize(data);
+	return HexStr(data.empty() ? NULL : &data[0], data.size());
+}
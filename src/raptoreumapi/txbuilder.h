@@ -0,0 +1,82 @@
+/**
+ * @file    txbuilder.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of an offline transaction builder that
+ * serializes unsigned transactions locally, in place of
+ * the createrawtransaction call.
+ */
+
+#ifndef RAPTOREUM_API_TXBUILDER_H
+#define RAPTOREUM_API_TXBUILDER_H
+
+#include "types.h"
+#include "script.h"
+
+#include <stdint.h>
+
+/*
+ * Inputs are added with empty scriptSigs, ready to be signed with
+ * signrawtransaction. Invalid txids or payloads throw a RaptoreumException
+ * with RPC_INVALID_PARAMETER, invalid addresses RPC_INVALID_ADDRESS_OR_KEY.
+ */
+class TransactionBuilder
+{
+
+private:
+    struct input_t{
+        unsigned char hash[32];
+        uint32_t n;
+        uint32_t sequence;
+    };
+
+    struct output_t{
+        int64_t satoshis;
+        std::vector<unsigned char> script;
+    };
+
+    chainparams_t params;
+    int version;
+    int type;
+    uint32_t locktime;
+    std::vector<unsigned char> extraPayload;
+    std::vector<input_t> inputs;
+    std::vector<output_t> outputs;
+
+public:
+    // Size of a signed P2PKH input (compressed key), for fee estimates
+    static const size_t P2PKH_INPUT_SIZE = 148;
+
+    explicit TransactionBuilder(const chainparams_t& params = MainNetParams());
+
+    TransactionBuilder& setVersion(int version);
+    TransactionBuilder& setType(int type);
+    TransactionBuilder& setLockTime(uint32_t locktime);
+    TransactionBuilder& setExtraPayload(const std::string& hex);
+
+    TransactionBuilder& addInput(const std::string& txid, unsigned int n, uint32_t sequence = 0xFFFFFFFF);
+    TransactionBuilder& addInput(const txout_t& outpoint, uint32_t sequence = 0xFFFFFFFF);
+    TransactionBuilder& addOutput(const std::string& address, int64_t satoshis);
+    TransactionBuilder& addOutput(const std::vector<unsigned char>& script, int64_t satoshis);
+    // Zero valued OP_RETURN output
+    TransactionBuilder& addData(const std::vector<unsigned char>& data);
+
+    // Drops inputs, outputs and payload, keeps version, type and locktime
+    void clear();
+
+    size_t inputCount() const;
+    size_t outputCount() const;
+    int64_t outputValue() const;
+
+    // Serialized size as built, and with every input signed as P2PKH
+    size_t size() const;
+    size_t signedSize() const;
+
+    void serialize(std::vector<unsigned char>& out) const;
+    std::string toHex() const;
+};
+
+
+#endif
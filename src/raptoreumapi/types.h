@@ -10,8 +10,10 @@
 #ifndef RAPTOREUM_API_TYPES_H
 #define RAPTOREUM_API_TYPES_H
 
+#include <map>
 #include <string>
 #include <vector>
+#include <stdint.h>
 
 #include <jsoncpp/json/json.h>
 
@@ -55,6 +57,41 @@
 		std::string account;
 	};
 
+	/* === Address index === */
+	struct addressdelta_t{
+		int64_t satoshis;
+		std::string txid;
+		unsigned int index;
+		unsigned int blockindex;
+		unsigned int height;
+		std::string address;
+	};
+
+	struct addressutxo_t{
+		std::string address;
+		std::string txid;
+		unsigned int outputIndex;
+		std::string script;
+		int64_t satoshis;
+		unsigned int height;
+	};
+
+	struct addressmempool_t{
+		std::string address;
+		std::string txid;
+		unsigned int index;
+		int64_t satoshis;
+		unsigned int timestamp;
+		std::string prevtxid;
+		unsigned int prevout;
+	};
+
+	struct spentinfo_t{
+		std::string txid;
+		unsigned int index;
+		unsigned int height;
+	};
+
 	/* === Transactions === */
 	struct transactiondetails_t{
 		std::string account;
@@ -109,22 +146,27 @@
 	};
 
 	struct vin_t: txout_t{
+		std::string coinbase;   // coinbase inputs have no txid and scriptSig
 		scriptSig_t scriptSig;
 		unsigned int sequence;
 	};
 
 	struct vout_t{
 		double value;
+		int64_t valueSat;
 		unsigned int n;
 		scriptPubKey_t scriptPubKey;
 	};
 
 	struct decoderawtransaction_t{
 		std::string txid;
+		unsigned int size;
 		int version;
+		int type;               // special transaction type, 0 for normal ones
 		int locktime;
 		std::vector<vin_t> vin;
 		std::vector<vout_t> vout;
+		std::string extraPayload;
 	};
 
 	/* getrawtransaction return type */
@@ -148,6 +190,50 @@
 		bool complete;
 	};
 
+	/* === Mempool === */
+	struct mempoolentry_t{
+		std::string txid;
+		unsigned int size;
+		int64_t fee;            // satoshis
+		int64_t feerate;        // satoshis per 1000 bytes
+		unsigned int time;
+		unsigned int height;
+	};
+
+	/* === Blocks === */
+	struct blockinfo_t{
+		std::string hash;
+		int confirmations;
+		int size;
+		int height;
+		int version;
+		std::string merkleroot;
+		std::vector<std::string> tx;
+		unsigned int time;
+		unsigned int nonce;
+		std::string bits;
+		double difficulty;
+		std::string chainwork;
+		std::string previousblockhash;
+		std::string nextblockhash;
+	};
+
+	struct blockheader_t{
+		std::string hash;
+		int version;
+		std::string previousblockhash;
+		std::string merkleroot;
+		unsigned int time;
+		std::string bits;
+		unsigned int nonce;
+	};
+
+	/* Block decoded from its serialized form (getblock verbosity 0) */
+	struct rawblock_t: blockheader_t{
+		int size;
+		std::vector<decoderawtransaction_t> tx;
+	};
+
 	/* === Unused yet === */
 
 	struct mininginfo_t{
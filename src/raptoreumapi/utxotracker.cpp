@@ -0,0 +1,403 @@
+/**
+ * @file    utxotracker.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of a local unspent output set that is kept
+ * up to date from the block stream.
+ */
+
+#include "utxotracker.h"
+#include "exception.h"
+#include "hex.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using std::string;
+using std::vector;
+
+/* Arena growth step and the least size at which it is compacted */
+static const size_t ARENA_CHUNK = 1 << 24;
+
+
+/* === Outpoints === */
+
+bool UtxoTracker::outpoint_t::operator==(const outpoint_t& other) const{
+	return n == other.n && std::memcmp(hash, other.hash, 32) == 0;
+}
+
+size_t UtxoTracker::outpoint_hash::operator()(const outpoint_t& outpoint) const{
+	/* Txids are already uniformly distributed */
+	uint64_t h;
+	std::memcpy(&h, outpoint.hash, sizeof(h));
+	return (size_t) (h ^ ((uint64_t) outpoint.n * 0x9E3779B97F4A7C15ULL));
+}
+
+static UtxoTracker::outpoint_t makeOutpoint(const string& txid, unsigned int n){
+	UtxoTracker::outpoint_t ret;
+	if(!ParseHash(txid, ret.hash)){
+		throw RaptoreumException(RPC_INVALID_PARAMETER, "Invalid txid " + txid);
+	}
+	ret.n = n;
+	return ret;
+}
+
+/* === Coin arena === */
+
+/* Record layout: satoshis (8), height (4), script length (4), address length (1), script, address */
+static const size_t RECORD_HEADER = 17;
+
+UtxoTracker::CoinArena::CoinArena(const string& file)
+: base(NULL), used(0), capacity(0), dead(0), fd(-1), file(file)
+{
+	if(!file.empty()){
+		fd = open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+		if(fd < 0){
+			throw RaptoreumException(RPC_DATABASE_ERROR, "Cannot open " + file);
+		}
+	}
+}
+
+UtxoTracker::CoinArena::~CoinArena(){
+	if(fd >= 0){
+		if(base != NULL){
+			munmap(base, capacity);
+		}
+		close(fd);
+	}else{
+		std::free(base);
+	}
+}
+
+void UtxoTracker::CoinArena::reserve(size_t size){
+	if(size <= capacity){
+		return;
+	}
+	size_t grown = ((size + ARENA_CHUNK - 1) / ARENA_CHUNK) * ARENA_CHUNK;
+	grown = std::max(grown, 2 * capacity);
+
+	if(fd < 0){
+		unsigned char * ptr = (unsigned char *) std::realloc(base, grown);
+		if(ptr == NULL){
+			throw std::bad_alloc();
+		}
+		base = ptr;
+	}else{
+		/* Records are addressed by offset, so the mapping may move */
+		if(base != NULL){
+			munmap(base, capacity);
+			base = NULL;
+		}
+		if(ftruncate(fd, grown) != 0){
+			throw RaptoreumException(RPC_DATABASE_ERROR, "Cannot grow " + file);
+		}
+		void * ptr = mmap(NULL, grown, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if(ptr == MAP_FAILED){
+			throw RaptoreumException(RPC_DATABASE_ERROR, "Cannot map " + file);
+		}
+		base = (unsigned char *) ptr;
+	}
+	capacity = grown;
+}
+
+uint64_t UtxoTracker::CoinArena::append(const coin_t& coin){
+	size_t size = RECORD_HEADER + coin.script.size() + coin.address.size();
+	reserve(used + size);
+
+	unsigned char * p = base + used;
+	uint32_t height = (uint32_t) coin.height;
+	uint32_t scriptLen = (uint32_t) coin.script.size();
+	unsigned char addressLen = (unsigned char) coin.address.size();
+
+	std::memcpy(p, &coin.satoshis, 8);
+	std::memcpy(p + 8, &height, 4);
+	std::memcpy(p + 12, &scriptLen, 4);
+	p[16] = addressLen;
+	std::memcpy(p + RECORD_HEADER, coin.script.data(), scriptLen);
+	std::memcpy(p + RECORD_HEADER + scriptLen, coin.address.data(), addressLen);
+
+	uint64_t offset = used;
+	used += size;
+	return offset;
+}
+
+void UtxoTracker::CoinArena::read(uint64_t offset, coin_t& coin) const{
+	const unsigned char * p = base + offset;
+	uint32_t height, scriptLen;
+
+	std::memcpy(&coin.satoshis, p, 8);
+	std::memcpy(&height, p + 8, 4);
+	std::memcpy(&scriptLen, p + 12, 4);
+	coin.height = (int) height;
+	coin.script.assign((const char *) p + RECORD_HEADER, scriptLen);
+	coin.address.assign((const char *) p + RECORD_HEADER + scriptLen, p[16]);
+}
+
+void UtxoTracker::CoinArena::release(uint64_t offset){
+	uint32_t scriptLen;
+	std::memcpy(&scriptLen, base + offset + 12, 4);
+	dead += RECORD_HEADER + scriptLen + base[offset + 16];
+}
+
+bool UtxoTracker::CoinArena::wasteful() const{
+	return used >= ARENA_CHUNK && 2 * dead > used;
+}
+
+void UtxoTracker::CoinArena::clear(){
+	used = 0;
+	dead = 0;
+}
+
+/* === Tracker === */
+
+UtxoTracker::UtxoTracker(RaptoreumAPI& rpc, const chainparams_t& params, unsigned int depth, const string& file)
+: rpc(rpc),
+  params(params),
+  depth(depth),
+  arena(file),
+  tipHeight(-1)
+{
+}
+
+void UtxoTracker::addCoin(const outpoint_t& outpoint, const coin_t& coin){
+	/* Duplicate txid (pre BIP30 style), the newer output wins */
+	coin_t old;
+	spendCoin(outpoint, old);
+
+	coins[outpoint] = arena.append(coin);
+
+	if(!coin.address.empty()){
+		addressaggregate_t& aggregate = aggregates[coin.address];
+		aggregate.balance += coin.satoshis;
+		aggregate.utxos += 1;
+		byAddress[coin.address].insert(outpoint);
+	}
+}
+
+bool UtxoTracker::spendCoin(const outpoint_t& outpoint, coin_t& coin){
+	coin_map::iterator it = coins.find(outpoint);
+	if(it == coins.end()){
+		return false;
+	}
+
+	arena.read(it->second, coin);
+	arena.release(it->second);
+	coins.erase(it);
+
+	if(!coin.address.empty()){
+		std::unordered_map<string, addressaggregate_t>::iterator agg = aggregates.find(coin.address);
+		agg->second.balance -= coin.satoshis;
+		agg->second.utxos -= 1;
+
+		std::unordered_map<string, outpoint_set>::iterator set = byAddress.find(coin.address);
+		set->second.erase(outpoint);
+		if(agg->second.utxos == 0){
+			aggregates.erase(agg);
+			byAddress.erase(set);
+		}
+	}
+	return true;
+}
+
+void UtxoTracker::compact(){
+	/* Reads every live record, then rewrites them from the start */
+	vector<std::pair<coin_map::iterator, coin_t> > live;
+	live.reserve(coins.size());
+	for(coin_map::iterator it = coins.begin(); it != coins.end(); it++){
+		live.push_back(std::make_pair(it, coin_t()));
+		arena.read(it->second, live.back().second);
+	}
+
+	arena.clear();
+	for(size_t i = 0; i < live.size(); ++i){
+		live[i].first->second = arena.append(live[i].second);
+	}
+}
+
+void UtxoTracker::connect(const rawblock_t& block, int height){
+	std::lock_guard<std::mutex> guard(lock);
+
+	if(!tipHash.empty() && block.previousblockhash != tipHash){
+		throw RaptoreumException(RPC_INVALID_PARAMETER, "Block " + block.hash + " does not extend the tracked tip");
+	}
+
+	blockundo_t blockUndo;
+	blockUndo.hash = block.hash;
+	blockUndo.previousblockhash = block.previousblockhash;
+	blockUndo.height = height;
+	outpoint_set created;
+
+	for(size_t t = 0; t < block.tx.size(); ++t){
+		const decoderawtransaction_t& tx = block.tx[t];
+
+		for(size_t i = 0; i < tx.vin.size(); ++i){
+			if(!tx.vin[i].coinbase.empty()){
+				continue;
+			}
+			outpoint_t outpoint = makeOutpoint(tx.vin[i].txid, tx.vin[i].n);
+			coin_t coin;
+			if(!spendCoin(outpoint, coin)){
+				continue;
+			}
+			/* Outputs created and spent within the block need no undo */
+			if(created.erase(outpoint) == 0){
+				blockUndo.spent.push_back(std::make_pair(outpoint, coin));
+			}
+		}
+
+		outpoint_t outpoint = makeOutpoint(tx.txid, 0);
+		for(size_t o = 0; o < tx.vout.size(); ++o){
+			const vout_t& output = tx.vout[o];
+			if(output.scriptPubKey.type == "nulldata"){
+				continue;
+			}
+
+			coin_t coin;
+			coin.satoshis = output.valueSat;
+			coin.height = height;
+			vector<unsigned char> script;
+			HexToBytes(output.scriptPubKey.hex, script);
+			coin.script.assign(script.begin(), script.end());
+			if(output.scriptPubKey.addresses.size() == 1){
+				coin.address = output.scriptPubKey.addresses[0];
+			}
+
+			outpoint.n = output.n;
+			addCoin(outpoint, coin);
+			created.insert(outpoint);
+		}
+	}
+
+	blockUndo.created.assign(created.begin(), created.end());
+	undo.push_back(blockUndo);
+	while(undo.size() > depth){
+		undo.pop_front();
+	}
+	tipHash = block.hash;
+	tipHeight = height;
+
+	if(arena.wasteful()){
+		compact();
+	}
+}
+
+void UtxoTracker::disconnect(const string& blockhash){
+	std::lock_guard<std::mutex> guard(lock);
+
+	if(undo.empty() || undo.back().hash != blockhash){
+		throw RaptoreumException(RPC_INVALID_PARAMETER, "Block " + blockhash + " is not the tracked tip or beyond the undo depth");
+	}
+
+	blockundo_t& blockUndo = undo.back();
+	coin_t coin;
+	for(size_t i = 0; i < blockUndo.created.size(); ++i){
+		spendCoin(blockUndo.created[i], coin);
+	}
+	for(size_t i = 0; i < blockUndo.spent.size(); ++i){
+		addCoin(blockUndo.spent[i].first, blockUndo.spent[i].second);
+	}
+
+	tipHash = blockUndo.previousblockhash;
+	tipHeight = blockUndo.height - 1;
+	undo.pop_back();
+}
+
+/* === ChainListener === */
+
+void UtxoTracker::blockConnected(const blockinfo_t& block){
+	connect(rpc.getBlockRaw(block.hash, params), block.height);
+}
+
+void UtxoTracker::blockDisconnected(const blockinfo_t& block){
+	disconnect(block.hash);
+}
+
+/* === Queries === */
+
+size_t UtxoTracker::size() const{
+	std::lock_guard<std::mutex> guard(lock);
+	return coins.size();
+}
+
+int UtxoTracker::height() const{
+	std::lock_guard<std::mutex> guard(lock);
+	return tipHeight;
+}
+
+string UtxoTracker::tip() const{
+	std::lock_guard<std::mutex> guard(lock);
+	return tipHash;
+}
+
+int64_t UtxoTracker::getAddressBalance(const string& address) const{
+	return getAddressAggregate(address).balance;
+}
+
+addressaggregate_t UtxoTracker::getAddressAggregate(const string& address) const{
+	std::lock_guard<std::mutex> guard(lock);
+	std::unordered_map<string, addressaggregate_t>::const_iterator it = aggregates.find(address);
+	if(it == aggregates.end()){
+		addressaggregate_t empty = { 0, 0 };
+		return empty;
+	}
+	return it->second;
+}
+
+vector<addressutxo_t> UtxoTracker::getAddressUtxos(const string& address) const{
+	std::lock_guard<std::mutex> guard(lock);
+	vector<addressutxo_t> ret;
+
+	std::unordered_map<string, outpoint_set>::const_iterator set = byAddress.find(address);
+	if(set == byAddress.end()){
+		return ret;
+	}
+
+	coin_t coin;
+	ret.reserve(set->second.size());
+	for(outpoint_set::const_iterator it = set->second.begin(); it != set->second.end(); it++){
+		arena.read(coins.find(*it)->second, coin);
+
+		addressutxo_t utxo;
+		utxo.address = address;
+		HexStr(it->hash, 32, utxo.txid, true);
+		utxo.outputIndex = it->n;
+		HexStr((const unsigned char *) coin.script.data(), coin.script.size(), utxo.script);
+		utxo.satoshis = coin.satoshis;
+		utxo.height = coin.height;
+		ret.push_back(utxo);
+	}
+
+	return ret;
+}
+
+bool UtxoTracker::getUtxo(const string& txid, unsigned int n, addressutxo_t& utxo) const{
+	outpoint_t outpoint;
+	if(!ParseHash(txid, outpoint.hash)){
+		return false;
+	}
+	outpoint.n = n;
+
+	std::lock_guard<std::mutex> guard(lock);
+	coin_map::const_iterator it = coins.find(outpoint);
+	if(it == coins.end()){
+		return false;
+	}
+
+	coin_t coin;
+	arena.read(it->second, coin);
+	utxo.address = coin.address;
+	utxo.txid = txid;
+	utxo.outputIndex = n;
+	HexStr((const unsigned char *) coin.script.data(), coin.script.size(), utxo.script);
+	utxo.satoshis = coin.satoshis;
+	utxo.height = coin.height;
+	return true;
+}
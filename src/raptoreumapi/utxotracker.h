@@ -0,0 +1,157 @@
+/**
+ * @file    utxotracker.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of a local unspent output set that is kept
+ * up to date from the block stream, with per-address
+ * aggregates for balance and unspent output queries.
+ */
+
+#ifndef RAPTOREUM_API_UTXOTRACKER_H
+#define RAPTOREUM_API_UTXOTRACKER_H
+
+#include "raptoreumapi.h"
+#include "chainfollower.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+/* Per address totals over the tracked unspent outputs */
+struct addressaggregate_t{
+	int64_t balance;
+	size_t utxos;
+};
+
+/*
+ * The set is only complete when fed from the genesis block (or from a
+ * point where it was complete). Outputs spent that were never seen are
+ * ignored. Coin data (amount, height, script, address) lives in an arena
+ * that is either heap memory or a memory mapped file; the outpoint and
+ * address indexes are always in memory.
+ *
+ * As a ChainListener it fetches each connected block with getBlockRaw,
+ * so it can be driven by a ChainFollower directly.
+ */
+class UtxoTracker: public ChainListener
+{
+
+public:
+    struct outpoint_t{
+        unsigned char hash[32];
+        uint32_t n;
+
+        bool operator==(const outpoint_t& other) const;
+    };
+
+    struct outpoint_hash{
+        size_t operator()(const outpoint_t& outpoint) const;
+    };
+
+private:
+    struct coin_t{
+        int64_t satoshis;
+        int height;
+        std::string script;     // binary
+        std::string address;    // empty if the script has no single address
+    };
+
+    /* What is needed to take a block back off */
+    struct blockundo_t{
+        std::string hash;
+        std::string previousblockhash;
+        int height;
+        std::vector<std::pair<outpoint_t, coin_t> > spent;
+        std::vector<outpoint_t> created;
+    };
+
+    /* Append-only record store, compacted when half of it is dead */
+    class CoinArena
+    {
+
+    private:
+        unsigned char * base;
+        size_t used;
+        size_t capacity;
+        size_t dead;
+        int fd;
+        std::string file;
+
+        void reserve(size_t size);
+
+    public:
+        explicit CoinArena(const std::string& file);
+        ~CoinArena();
+
+        uint64_t append(const coin_t& coin);
+        void read(uint64_t offset, coin_t& coin) const;
+        void release(uint64_t offset);
+
+        bool wasteful() const;
+        void clear();
+    };
+
+    typedef std::unordered_map<outpoint_t, uint64_t, outpoint_hash> coin_map;
+    typedef std::unordered_set<outpoint_t, outpoint_hash> outpoint_set;
+
+    RaptoreumAPI& rpc;
+    chainparams_t params;
+    unsigned int depth;
+
+    mutable std::mutex lock;
+    CoinArena arena;
+    coin_map coins;
+    std::unordered_map<std::string, addressaggregate_t> aggregates;
+    std::unordered_map<std::string, outpoint_set> byAddress;
+    std::deque<blockundo_t> undo;
+    int tipHeight;
+    std::string tipHash;
+
+    UtxoTracker(const UtxoTracker& other);
+    UtxoTracker& operator=(const UtxoTracker& other);
+
+    void addCoin(const outpoint_t& outpoint, const coin_t& coin);
+    bool spendCoin(const outpoint_t& outpoint, coin_t& coin);
+    void compact();
+
+public:
+    /* depth: number of blocks that can be disconnected again
+     * file:  backing file for the coin arena, heap memory if empty; a
+     *        file that cannot be created throws a RaptoreumException
+     *        with RPC_DATABASE_ERROR */
+    UtxoTracker(RaptoreumAPI& rpc, const chainparams_t& params = MainNetParams(),
+                unsigned int depth = 100, const std::string& file = "");
+
+    // Applies a block on top of the tracked tip. Throws a
+    // RaptoreumException with RPC_INVALID_PARAMETER if it does not
+    // extend it.
+    void connect(const rawblock_t& block, int height);
+
+    // Takes the tip block back off, restoring the outputs it spent.
+    // Throws a RaptoreumException with RPC_INVALID_PARAMETER for any
+    // other block or beyond depth.
+    void disconnect(const std::string& blockhash);
+
+    /* === ChainListener === */
+
+    void blockConnected(const blockinfo_t& block);
+    void blockDisconnected(const blockinfo_t& block);
+
+    /* === Queries === */
+
+    size_t size() const;
+    int height() const;
+    std::string tip() const;
+
+    // Balance in satoshis
+    int64_t getAddressBalance(const std::string& address) const;
+    addressaggregate_t getAddressAggregate(const std::string& address) const;
+    std::vector<addressutxo_t> getAddressUtxos(const std::string& address) const;
+    bool getUtxo(const std::string& txid, unsigned int n, addressutxo_t& utxo) const;
+};
+
+
+#endif
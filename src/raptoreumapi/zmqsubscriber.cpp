@@ -0,0 +1,192 @@
+/**
+ * @file    zmqsubscriber.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Implementation of a subscriber for the ZeroMQ notifications
+ * published by the Raptoreum daemon.
+ */
+
+#include "zmqsubscriber.h"
+#include "exception.h"
+#include "block.h"
+#include "transaction.h"
+#include "hex.h"
+
+#include <vector>
+
+#include <zmq.h>
+
+using jsonrpc::Errors;
+
+using std::map;
+using std::string;
+using std::vector;
+
+
+static void throwZmqError(const string& what){
+	throw RaptoreumException(Errors::ERROR_CLIENT_CONNECTOR,
+	                         what + ": " + zmq_strerror(zmq_errno()));
+}
+
+ZmqSubscriber::ZmqSubscriber(const string& endpoint, ZmqListener& listener, const chainparams_t& params)
+: context(NULL),
+  socket(NULL),
+  listener(listener),
+  rpc(NULL),
+  params(params)
+{
+	connect(endpoint);
+}
+
+ZmqSubscriber::ZmqSubscriber(const string& endpoint, ZmqListener& listener, RaptoreumAPI& rpc,
+                             const chainparams_t& params)
+: context(NULL),
+  socket(NULL),
+  listener(listener),
+  rpc(&rpc),
+  params(params)
+{
+	connect(endpoint);
+}
+
+void ZmqSubscriber::connect(const string& endpoint){
+	context = zmq_ctx_new();
+	if(context == NULL){
+		throwZmqError("Failed to create ZeroMQ context");
+	}
+
+	socket = zmq_socket(context, ZMQ_SUB);
+	int linger = 0;
+	if(socket == NULL
+	   || zmq_setsockopt(socket, ZMQ_LINGER, &linger, sizeof(linger)) != 0
+	   || zmq_connect(socket, endpoint.c_str()) != 0){
+		if(socket != NULL){
+			zmq_close(socket);
+		}
+		zmq_ctx_term(context);
+		throwZmqError("Failed to connect to " + endpoint);
+	}
+}
+
+ZmqSubscriber::~ZmqSubscriber()
+{
+	zmq_close(socket);
+	zmq_ctx_term(context);
+}
+
+void ZmqSubscriber::subscribe(const string& topic){
+	if(zmq_setsockopt(socket, ZMQ_SUBSCRIBE, topic.data(), topic.size()) != 0){
+		throwZmqError("Failed to subscribe to " + topic);
+	}
+}
+
+void ZmqSubscriber::reset(){
+	sequences.clear();
+}
+
+/* Replays the main chain blocks after lastBlock up to, but not including,
+   until */
+void ZmqSubscriber::catchUp(const string& until){
+	if(rpc == NULL || lastBlock.empty() || lastBlock == until){
+		return;
+	}
+
+	/* A block reorganized away has no confirmations, resume at the fork */
+	blockinfo_t last = rpc->getBlock(lastBlock);
+	while(last.confirmations < 0){
+		rpc->getBlock(last.previousblockhash, last);
+	}
+
+	int stop = rpc->getBlock(until).height;
+	for(int height = last.height + 1; height < stop; ++height){
+		rawblock_t block = rpc->getBlockRaw(rpc->getBlockHash(height), params);
+		lastBlock = block.hash;
+		listener.block(block);
+	}
+}
+
+bool ZmqSubscriber::poll(long timeout){
+	zmq_pollitem_t item = { socket, 0, ZMQ_POLLIN, 0 };
+
+	int ready = zmq_poll(&item, 1, timeout);
+	if(ready < 0){
+		throwZmqError("Failed to poll ZeroMQ socket");
+	}
+	if(ready == 0){
+		return false;
+	}
+
+	/* Notifications are [topic, body, 4 byte little endian sequence] */
+	vector<string> parts;
+	int more = 1;
+	while(more){
+		zmq_msg_t msg;
+		zmq_msg_init(&msg);
+		if(zmq_msg_recv(&msg, socket, 0) < 0){
+			zmq_msg_close(&msg);
+			throwZmqError("Failed to receive ZeroMQ message");
+		}
+		parts.push_back(string((const char *) zmq_msg_data(&msg), zmq_msg_size(&msg)));
+		more = zmq_msg_more(&msg);
+		zmq_msg_close(&msg);
+	}
+
+	if(parts.size() < 2){
+		return true;
+	}
+
+	const string& topic = parts[0];
+	const string& body = parts[1];
+
+	/* Check the sequence first, a gap is reported before the
+	   notification that revealed it */
+	unsigned int sequence = 0;
+	bool missed = false;
+	if(parts.size() >= 3 && parts[2].size() == 4){
+		const unsigned char * seq = (const unsigned char *) parts[2].data();
+		sequence = seq[0] | (seq[1] << 8) | (seq[2] << 16) | ((unsigned int) seq[3] << 24);
+
+		map<string, unsigned int>::iterator it = sequences.find(topic);
+		if(it != sequences.end() && it->second != sequence){
+			/* Counters wrap around, so the difference stays meaningful */
+			listener.gap(topic, sequence - it->second);
+			missed = true;
+		}
+		sequences[topic] = sequence + 1;
+	}
+
+	if(topic == "rawblock"){
+		rawblock_t block;
+		DecodeBlock((const unsigned char *) body.data(), body.size(), block, params);
+		if(missed){
+			catchUp(block.hash);
+		}
+		lastBlock = block.hash;
+		listener.block(block);
+
+	}else if(topic == "rawtx"){
+		decoderawtransaction_t tx;
+		if(DecodeTransaction((const unsigned char *) body.data(), body.size(), tx, params) != body.size()){
+			throw RaptoreumException(Errors::ERROR_CLIENT_INVALID_RESPONSE, "Invalid transaction: trailing data");
+		}
+		listener.transaction(tx);
+
+	}else{
+		zmqnotification_t notification;
+		notification.topic = topic;
+		HexStr((const unsigned char *) body.data(), body.size(), notification.hex);
+		notification.sequence = sequence;
+
+		if(topic == "hashblock"){
+			if(missed){
+				catchUp(notification.hex);
+			}
+			lastBlock = notification.hex;
+		}
+		listener.notification(notification);
+	}
+
+	return true;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file    zmqsubscriber.h
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Declaration of a subscriber for the ZeroMQ notifications
+ * (hashblock, hashtx, rawblock, rawtx) published by the
+ * Raptoreum daemon. Only built when ZeroMQ is available.
+ */
+
+#ifndef RAPTOREUM_API_ZMQSUBSCRIBER_H
+#define RAPTOREUM_API_ZMQSUBSCRIBER_H
+
+#include "raptoreumapi.h"
+
+#include <map>
+#include <string>
+
+struct zmqnotification_t{
+	std::string topic;
+	std::string hex;         // hash announced by hashblock or hashtx
+	unsigned int sequence;
+};
+
+/* Receives the notifications read by a ZmqSubscriber */
+class ZmqListener
+{
+
+public:
+    virtual ~ZmqListener() { }
+
+    // hashblock and hashtx notifications
+    virtual void notification(const zmqnotification_t& notification) { }
+    // rawblock notifications, decoded, and blocks replayed after a gap
+    virtual void block(const rawblock_t& block) { }
+    // rawtx notifications, decoded
+    virtual void transaction(const decoderawtransaction_t& tx) { }
+
+    // Messages of topic were lost (missed of them, 0 if unknown). Missed
+    // blocks are replayed through block() before the notification that
+    // revealed the gap when the subscriber has an RPC connection; lost
+    // transactions have to be caught up with a mempool refresh.
+    virtual void gap(const std::string& topic, unsigned int missed) { }
+};
+
+class ZmqSubscriber
+{
+
+private:
+    void * context;
+    void * socket;
+    ZmqListener& listener;
+    RaptoreumAPI * rpc;
+    chainparams_t params;
+
+    // Next sequence number expected per topic
+    std::map<std::string, unsigned int> sequences;
+    // Hash of the last block notified, where a catch-up starts
+    std::string lastBlock;
+
+    void connect(const std::string& endpoint);
+    void catchUp(const std::string& until);
+
+    ZmqSubscriber(const ZmqSubscriber& other);
+    ZmqSubscriber& operator=(const ZmqSubscriber& other);
+
+public:
+    /* endpoint as given to -zmqpub* on the daemon, e.g. tcp://127.0.0.1:28332 */
+    ZmqSubscriber(const std::string& endpoint, ZmqListener& listener,
+                  const chainparams_t& params = MainNetParams());
+    // Same, catching up missed blocks with getBlockRaw on rpc
+    ZmqSubscriber(const std::string& endpoint, ZmqListener& listener, RaptoreumAPI& rpc,
+                  const chainparams_t& params = MainNetParams());
+    ~ZmqSubscriber();
+
+    void subscribe(const std::string& topic);
+
+    // Waits up to timeout milliseconds (-1 forever) for one notification
+    // and dispatches it. Returns false on timeout. Throws a
+    // RaptoreumException on a malformed rawblock or rawtx body.
+    bool poll(long timeout = -1);
+
+    // Forget the sequence numbers, e.g. after the daemon restarted
+    void reset();
+};
+
+
+#endif
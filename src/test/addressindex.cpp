@@ -0,0 +1,164 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <raptoreumapi/txbuilder.h>
+#include <raptoreumapi/transaction.h>
+#include "main.h"
+
+/* Height of the mock coinbase spent in the mempool by these tests */
+static const int SPENT_HEIGHT = 7;
+
+/* Broadcasts a spend of that coinbase to another address, once per run,
+   and returns its txid */
+static std::string spendCoinbase(MyFixture& fx, std::string& coinbase) {
+	NO_THROW(coinbase = fx.btc.getBlock(fx.btc.getBlockHash(SPENT_HEIGHT)).tx[0]);
+
+	TransactionBuilder builder;
+	builder.addInput(coinbase, 0).addOutput("RDqUvHcXEhrNFtWx3xtRgEvKmXuR3pUjNc", MOCK_COINBASE_REWARD - 100000000);
+	std::string hex = builder.toHex();
+
+	getrawtransaction_t tx;
+	DecodeRawTransaction(hex, tx);
+
+	/* Already in the mempool when another test sent it first */
+	std::vector<int> errors;
+	NO_THROW(fx.btc.sendRawTransactions(std::vector<std::string>(1, hex), errors));
+	BOOST_REQUIRE(errors[0] == 0 || errors[0] == -26);
+	return tx.txid;
+}
+
+BOOST_AUTO_TEST_SUITE(AddressIndexTests)
+
+BOOST_AUTO_TEST_CASE(GetAddressDeltas) {
+
+	/* Exact values of the synthetic chain */
+	if(liveHost()) {
+		return;
+	}
+
+	MyFixture fx;
+	std::vector<std::string> addresses(1, mockconfig_t().address);
+	std::vector<addressdelta_t> response;
+	int blocks = 0;
+
+	NO_THROW(blocks = fx.btc.getBlockCount() + 1);
+	NO_THROW(response = fx.btc.getAddressDeltas(addresses));
+
+	/* One coinbase output per block, in height order */
+	BOOST_REQUIRE(response.size() == (size_t) blocks);
+	int64_t total = 0;
+	for(size_t i = 0; i < response.size(); i++){
+		BOOST_REQUIRE(response[i].height == i);
+		BOOST_REQUIRE(response[i].index == 0 && response[i].blockindex == 0);
+		BOOST_REQUIRE(response[i].address == addresses[0]);
+		total += response[i].satoshis;
+	}
+	BOOST_REQUIRE(total == blocks * MOCK_COINBASE_REWARD);
+
+	#ifdef VERBOSE
+	std::cout << "=== getaddressdeltas ===" << std::endl;
+	for(std::vector<addressdelta_t>::iterator it = response.begin(); it != response.end(); it++){
+		std::cout << (*it).height << " " << (*it).txid << ":" << (*it).index << " " << (*it).satoshis << std::endl;
+	}
+	std::cout << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_CASE(GetAddressUtxos) {
+
+	if(liveHost()) {
+		return;
+	}
+
+	MyFixture fx;
+	std::vector<std::string> addresses(1, mockconfig_t().address);
+	std::vector<addressutxo_t> response;
+	std::string coinbase;
+	int blocks = 0;
+
+	NO_THROW(blocks = fx.btc.getBlockCount() + 1);
+	NO_THROW(response = fx.btc.getAddressUtxos(addresses));
+
+	BOOST_REQUIRE(response.size() == (size_t) blocks);
+	NO_THROW(coinbase = fx.btc.getBlock(fx.btc.getBlockHash(SPENT_HEIGHT)).tx[0]);
+	BOOST_REQUIRE(response[SPENT_HEIGHT].txid == coinbase);
+	for(size_t i = 0; i < response.size(); i++){
+		BOOST_REQUIRE(response[i].height == i && response[i].outputIndex == 0);
+		BOOST_REQUIRE(response[i].satoshis == MOCK_COINBASE_REWARD);
+	}
+
+	#ifdef VERBOSE
+	std::cout << "=== getaddressutxos ===" << std::endl;
+	for(std::vector<addressutxo_t>::iterator it = response.begin(); it != response.end(); it++){
+		std::cout << (*it).txid << ":" << (*it).outputIndex << " " << (*it).satoshis << std::endl;
+	}
+	std::cout << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_CASE(GetAddressMempool) {
+
+	/* Broadcasts a spend */
+	if(liveHost()) {
+		return;
+	}
+
+	MyFixture fx;
+	std::vector<std::string> addresses(1, mockconfig_t().address);
+	std::vector<addressmempool_t> response;
+	std::string coinbase;
+	std::string txid = spendCoinbase(fx, coinbase);
+
+	NO_THROW(response = fx.btc.getAddressMempool(addresses));
+
+	/* The spent coinbase output, as a negative delta */
+	BOOST_REQUIRE(response.size() == 1);
+	BOOST_REQUIRE(response[0].txid == txid && response[0].index == 0);
+	BOOST_REQUIRE(response[0].satoshis == -MOCK_COINBASE_REWARD);
+	BOOST_REQUIRE(response[0].prevtxid == coinbase && response[0].prevout == 0);
+
+	/* and the output it pays to */
+	addresses[0] = "RDqUvHcXEhrNFtWx3xtRgEvKmXuR3pUjNc";
+	NO_THROW(response = fx.btc.getAddressMempool(addresses));
+	BOOST_REQUIRE(response.size() == 1);
+	BOOST_REQUIRE(response[0].txid == txid && response[0].satoshis == MOCK_COINBASE_REWARD - 100000000);
+
+	#ifdef VERBOSE
+	std::cout << "=== getaddressmempool ===" << std::endl;
+	for(std::vector<addressmempool_t>::iterator it = response.begin(); it != response.end(); it++){
+		std::cout << (*it).txid << ":" << (*it).index << " " << (*it).satoshis << std::endl;
+	}
+	std::cout << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_CASE(GetSpentInfo) {
+
+	if(liveHost()) {
+		return;
+	}
+
+	MyFixture fx;
+	spentinfo_t response;
+	std::string coinbase;
+	std::string txid = spendCoinbase(fx, coinbase);
+
+	NO_THROW(response = fx.btc.getSpentInfo(coinbase, 0));
+	BOOST_REQUIRE(response.txid == txid);
+	BOOST_REQUIRE(response.index == 0);
+
+	/* An output nothing spends */
+	try{
+		fx.btc.getSpentInfo(coinbase, 1);
+		BOOST_REQUIRE_MESSAGE(false, "unspent output reported as spent");
+	}catch(RaptoreumException& e){
+		BOOST_REQUIRE(e.getCode() == RPC_INVALID_ADDRESS_OR_KEY);
+	}
+
+	#ifdef VERBOSE
+	std::cout << "=== getspentinfo ===" << std::endl;
+	std::cout << "Spent in: " << response.txid << ":" << response.index << " at " << response.height << std::endl << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
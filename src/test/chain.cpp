@@ -0,0 +1,372 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <raptoreumapi/chainscanner.h>
+#include <raptoreumapi/chainfollower.h>
+#include <raptoreumapi/block.h>
+#include <raptoreumapi/utxotracker.h>
+#include <raptoreumapi/hash.h>
+#include <raptoreumapi/hex.h>
+#include "main.h"
+#include <algorithm>
+#include <cstdio>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* Leaf i is the double SHA-256 of its two byte little endian index */
+static std::vector<unsigned char> merkleLeaves(size_t count){
+	std::vector<unsigned char> leaves(32 * count);
+	for(size_t i = 0; i < count; i++){
+		unsigned char index[2] = { (unsigned char) i, (unsigned char) (i >> 8) };
+		DoubleSha256(index, 2, &leaves[32 * i]);
+	}
+	return leaves;
+}
+
+/* Root in internal byte order, as hex */
+static std::string merkleRoot(const std::vector<unsigned char>& leaves, size_t count, bool& mutated,
+                              unsigned int threads = 1){
+	unsigned char root[32];
+	ComputeMerkleRoot(&leaves[0], count, root, &mutated, threads);
+	return HexStr(root, 32);
+}
+
+BOOST_AUTO_TEST_SUITE(ChainTests)
+
+BOOST_AUTO_TEST_CASE(ComputeMerkleRootVectors) {
+
+	std::vector<unsigned char> leaves = merkleLeaves(5);
+	bool mutated = true;
+
+	/* A single txid is its own root */
+	BOOST_REQUIRE(merkleRoot(leaves, 1, mutated) == HexStr(&leaves[0], 32));
+	BOOST_REQUIRE(!mutated);
+
+	BOOST_REQUIRE(merkleRoot(leaves, 2, mutated) == "06a7b41e63a5c4faedfe60dcd6ce3e31b1b402e3543fe22b3010df62a34f18b3");
+	BOOST_REQUIRE(!mutated);
+
+	/* Odd levels pair their last hash with itself */
+	BOOST_REQUIRE(merkleRoot(leaves, 3, mutated) == "793696c5b031f5d1f25c78573116a9f7bd90a789e67ad141f9afc44503db3703");
+	BOOST_REQUIRE(!mutated);
+	BOOST_REQUIRE(merkleRoot(leaves, 5, mutated) == "b18b1dc04a8e58aec4654bdb3c3b167c77bda1ac39ee453103889ebda7fad6a1");
+	BOOST_REQUIRE(!mutated);
+
+	/* Repeating the last txid gives the same root, but is flagged */
+	std::vector<unsigned char> duplicated(leaves.begin(), leaves.begin() + 3 * 32);
+	duplicated.insert(duplicated.end(), leaves.begin() + 2 * 32, leaves.begin() + 3 * 32);
+	BOOST_REQUIRE(merkleRoot(duplicated, 4, mutated) == "793696c5b031f5d1f25c78573116a9f7bd90a789e67ad141f9afc44503db3703");
+	BOOST_REQUIRE(mutated);
+}
+
+BOOST_AUTO_TEST_CASE(ComputeMerkleRootThreads) {
+
+	/* 10000 pairs on the first level, above the 2048 pairs per thread
+	   a level needs before it is split */
+	std::vector<unsigned char> leaves = merkleLeaves(20000);
+	bool mutated = true;
+	std::string single = merkleRoot(leaves, leaves.size() / 32, mutated, 1);
+
+	BOOST_REQUIRE(single == "f2ec45bfea9ef3b5678f15ee64466dbc1d74fd9890031b4d0320016c226e3745");
+	BOOST_REQUIRE(!mutated);
+
+	mutated = true;
+	BOOST_REQUIRE(merkleRoot(leaves, leaves.size() / 32, mutated, 8) == single);
+	BOOST_REQUIRE(!mutated);
+
+	/* Also through the single message kernel */
+	std::string kernel = Sha256Implementation();
+	if(SetSha256Implementation("scalar")){
+		BOOST_REQUIRE(merkleRoot(leaves, leaves.size() / 32, mutated, 8) == single);
+	}
+	SetSha256Implementation(kernel.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(ScanBlockRange) {
+
+	MyFixture fx;
+	ChainScanner scanner(fx.btc, 4, 16);
+	int expected = 1;
+
+	NO_THROW(scanner.scan(1, 100, [&expected](const blockinfo_t& block) {
+		BOOST_REQUIRE(block.height == expected);
+		BOOST_REQUIRE(block.hash.size() == 64);
+		++expected;
+	}));
+	BOOST_REQUIRE(expected == 101);
+
+	#ifdef VERBOSE
+	std::cout << "=== chainscanner ===" << std::endl;
+	std::cout << "Blocks delivered: " << expected - 1 << std::endl << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_CASE(GetBlockRaw) {
+
+	MyFixture fx;
+	std::string hash;
+	blockinfo_t expected;
+	rawblock_t response;
+
+	NO_THROW(hash = fx.btc.getBestBlockHash());
+	NO_THROW(expected = fx.btc.getBlock(hash));
+	NO_THROW(response = fx.btc.getBlockRaw(hash));
+
+	BOOST_REQUIRE(response.hash == expected.hash);
+	BOOST_REQUIRE(response.merkleroot == expected.merkleroot);
+	BOOST_REQUIRE(response.previousblockhash == expected.previousblockhash);
+	BOOST_REQUIRE(response.size == expected.size);
+	BOOST_REQUIRE(response.tx.size() == expected.tx.size());
+	for(size_t i = 0; i < response.tx.size(); i++){
+		BOOST_REQUIRE(response.tx[i].txid == expected.tx[i]);
+	}
+	BOOST_REQUIRE(CheckMerkleRoot(response));
+	BOOST_REQUIRE(CheckMerkleRoot(expected));
+
+	#ifdef VERBOSE
+	std::cout << "=== getblockraw ===" << std::endl;
+	std::cout << "Hash: " << response.hash << std::endl;
+	std::cout << "Transactions: " << response.tx.size() << std::endl << std::endl;
+	#endif
+}
+
+struct CountingListener: ChainListener {
+	int connected;
+	int disconnected;
+
+	CountingListener() : connected(0), disconnected(0) { }
+	void blockConnected(const blockinfo_t& block) { ++connected; }
+	void blockDisconnected(const blockinfo_t& block) { ++disconnected; }
+};
+
+BOOST_AUTO_TEST_CASE(FollowChainTip) {
+
+	MyFixture fx;
+	CountingListener listener;
+	ChainFollower follower(fx.btc, listener, 10);
+
+	NO_THROW(follower.poll());
+	BOOST_REQUIRE(listener.connected == 1);
+	BOOST_REQUIRE(listener.disconnected == 0);
+	BOOST_REQUIRE(follower.tip().hash.size() == 64);
+
+	#ifdef VERBOSE
+	std::cout << "=== chainfollower ===" << std::endl;
+	std::cout << "Tip: " << follower.tip().height << " " << follower.tip().hash << std::endl << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_CASE(FollowTipBack) {
+
+	if(liveHost()){
+		return;
+	}
+
+	MyFixture fx;
+	CountingListener listener;
+	ChainFollower follower(fx.btc, listener, 10);
+	int height = fx.btc.getBlockCount();
+
+	NO_THROW(follower.start(fx.btc.getBlockHash(height - 4)));
+	NO_THROW(follower.poll());
+	BOOST_REQUIRE(listener.connected == 4 && follower.tip().height == height);
+
+	/* The best block moves back to one already followed */
+	mockDaemon().setResponse("getbestblockhash", Json::Value(fx.btc.getBlockHash(height - 2)));
+	BOOST_REQUIRE(follower.poll());
+	BOOST_REQUIRE(listener.disconnected == 2 && follower.tip().height == height - 2);
+	BOOST_REQUIRE(!follower.poll());
+
+	/* A fork point below the window */
+	mockDaemon().clearResponses();
+	mockDaemon().setResponse("getbestblockhash", Json::Value(fx.btc.getBlockHash(height - 50)));
+	try{
+		follower.poll();
+		BOOST_REQUIRE_MESSAGE(false, "reorganization below the window followed");
+	}catch(RaptoreumException& e){
+		BOOST_REQUIRE(e.getError() == RPC_REORG_TOO_DEEP);
+	}
+	mockDaemon().clearResponses();
+}
+
+BOOST_AUTO_TEST_CASE(TrackUtxos) {
+
+	MyFixture fx;
+	UtxoTracker tracker(fx.btc);
+	ChainFollower follower(fx.btc, tracker, 10);
+
+	NO_THROW(follower.poll());
+	BOOST_REQUIRE(tracker.tip() == follower.tip().hash);
+	BOOST_REQUIRE(tracker.height() == follower.tip().height);
+	BOOST_REQUIRE(tracker.size() >= 1);
+
+	NO_THROW(tracker.disconnect(follower.tip().hash));
+	BOOST_REQUIRE(tracker.size() == 0);
+
+	/* Only the tip can be taken back off */
+	try{
+		tracker.disconnect(follower.tip().hash);
+		BOOST_REQUIRE_MESSAGE(false, "block disconnected twice");
+	}catch(RaptoreumException& e){
+		BOOST_REQUIRE(e.getError() == RPC_INVALID_PARAMETER);
+		BOOST_REQUIRE(e.getMessage().find(follower.tip().hash) != std::string::npos);
+	}
+
+	#ifdef VERBOSE
+	std::cout << "=== utxotracker ===" << std::endl;
+	std::cout << "Tip: " << tracker.height() << " " << tracker.tip() << std::endl << std::endl;
+	#endif
+}
+
+/* Transaction with txid 64 times id, spending the given outpoints
+   (a coinbase without any) and paying the given addresses */
+static decoderawtransaction_t utxoTx(char id, const std::vector<txout_t>& spends,
+                                     const std::vector<std::pair<std::string, int64_t> >& pays){
+	decoderawtransaction_t tx;
+	tx.txid = std::string(64, id);
+	tx.vin.resize(std::max<size_t>(spends.size(), 1));
+	if(spends.empty()){
+		tx.vin[0].coinbase = "51";
+	}
+	for(size_t i = 0; i < spends.size(); i++){
+		tx.vin[i].txid = spends[i].txid;
+		tx.vin[i].n = spends[i].n;
+	}
+	tx.vout.resize(pays.size());
+	for(size_t o = 0; o < pays.size(); o++){
+		tx.vout[o].n = o;
+		tx.vout[o].valueSat = pays[o].second;
+		if(pays[o].first.empty()){
+			tx.vout[o].scriptPubKey.type = "nulldata";
+			tx.vout[o].scriptPubKey.hex = "6a";
+			continue;
+		}
+		tx.vout[o].scriptPubKey.type = "pubkeyhash";
+		tx.vout[o].scriptPubKey.hex = "76a914" + std::string(40, id) + "88ac";
+		tx.vout[o].scriptPubKey.addresses.push_back(pays[o].first);
+	}
+	return tx;
+}
+
+static txout_t utxoSpend(char id, unsigned int n){
+	txout_t ret;
+	ret.txid = std::string(64, id);
+	ret.n = n;
+	return ret;
+}
+
+/* Unspent outputs of an address as sorted "txid:n satoshis height" */
+static std::vector<std::string> utxoSummary(const UtxoTracker& tracker, const std::string& address){
+	std::vector<addressutxo_t> utxos = tracker.getAddressUtxos(address);
+	std::vector<std::string> ret;
+	for(size_t i = 0; i < utxos.size(); i++){
+		std::ostringstream line;
+		line << utxos[i].txid.substr(0, 1) << ":" << utxos[i].outputIndex << " " << utxos[i].satoshis << " " << utxos[i].height;
+		ret.push_back(line.str());
+	}
+	std::sort(ret.begin(), ret.end());
+	return ret;
+}
+
+static void checkUtxos(const UtxoTracker& tracker, const std::string& address, int64_t balance, const char * expected){
+	std::vector<std::string> summary = utxoSummary(tracker, address);
+	std::string joined;
+	for(size_t i = 0; i < summary.size(); i++){
+		joined += (i > 0 ? ", " : "") + summary[i];
+	}
+	BOOST_REQUIRE_MESSAGE(joined == expected, address << ": " << joined);
+	BOOST_REQUIRE(tracker.getAddressBalance(address) == balance);
+	BOOST_REQUIRE(tracker.getAddressAggregate(address).balance == balance);
+	BOOST_REQUIRE(tracker.getAddressAggregate(address).utxos == summary.size());
+}
+
+BOOST_AUTO_TEST_CASE(TrackUtxoSpends) {
+
+	MyFixture fx;
+	std::vector<rawblock_t> blocks(3);
+	typedef std::pair<std::string, int64_t> pay;
+
+	/* 1: a coinbase paying A and B */
+	blocks[0].hash = std::string(64, 'a');
+	blocks[0].tx.push_back(utxoTx('1', std::vector<txout_t>(), { pay("A", 5000), pay("B", 3000) }));
+
+	/* 2: A's coin spent from block 1, and the change spent again within
+	   the block, next to a data output that is never tracked */
+	blocks[1].hash = std::string(64, 'b');
+	blocks[1].tx.push_back(utxoTx('2', std::vector<txout_t>(), { pay("C", 1000) }));
+	blocks[1].tx.push_back(utxoTx('3', { utxoSpend('1', 0) }, { pay("B", 2000), pay("A", 2900) }));
+	blocks[1].tx.push_back(utxoTx('4', { utxoSpend('3', 1) }, { pay("C", 2800), pay("", 0) }));
+
+	/* 3: B's coins from both earlier blocks joined to A */
+	blocks[2].hash = std::string(64, 'c');
+	blocks[2].tx.push_back(utxoTx('5', { utxoSpend('1', 1), utxoSpend('3', 0) }, { pay("A", 4900) }));
+
+	for(size_t b = 1; b < blocks.size(); b++){
+		blocks[b].previousblockhash = blocks[b - 1].hash;
+	}
+
+	/* Once with the coins on the heap, once in a memory mapped file */
+	char path[] = "/tmp/raptoreumapi-utxos-XXXXXX";
+	int fd = mkstemp(path);
+	BOOST_REQUIRE(fd >= 0);
+	close(fd);
+	const std::string files[] = { "", path };
+
+	for(size_t f = 0; f < 2; f++){
+		UtxoTracker tracker(fx.btc, MainNetParams(), 10, files[f]);
+
+		NO_THROW(tracker.connect(blocks[0], 1));
+		BOOST_REQUIRE(tracker.size() == 2);
+		checkUtxos(tracker, "A", 5000, "1:0 5000 1");
+		checkUtxos(tracker, "B", 3000, "1:1 3000 1");
+
+		/* Only blocks on top of the tip */
+		try{
+			tracker.connect(blocks[2], 2);
+			BOOST_REQUIRE_MESSAGE(false, "block not extending the tip connected");
+		}catch(RaptoreumException& e){
+			BOOST_REQUIRE(e.getError() == RPC_INVALID_PARAMETER);
+		}
+
+		NO_THROW(tracker.connect(blocks[1], 2));
+		BOOST_REQUIRE(tracker.size() == 4);
+		checkUtxos(tracker, "A", 0, "");
+		checkUtxos(tracker, "B", 5000, "1:1 3000 1, 3:0 2000 2");
+		checkUtxos(tracker, "C", 3800, "2:0 1000 2, 4:0 2800 2");
+
+		NO_THROW(tracker.connect(blocks[2], 3));
+		BOOST_REQUIRE(tracker.size() == 3 && tracker.height() == 3 && tracker.tip() == blocks[2].hash);
+		checkUtxos(tracker, "A", 4900, "5:0 4900 3");
+		checkUtxos(tracker, "B", 0, "");
+		checkUtxos(tracker, "C", 3800, "2:0 1000 2, 4:0 2800 2");
+
+		addressutxo_t utxo;
+		BOOST_REQUIRE(tracker.getUtxo(std::string(64, '5'), 0, utxo));
+		BOOST_REQUIRE(utxo.address == "A" && utxo.script == "76a914" + std::string(40, '5') + "88ac");
+		BOOST_REQUIRE(!tracker.getUtxo(std::string(64, '1'), 1, utxo));
+		BOOST_REQUIRE(!tracker.getUtxo(std::string(64, '4'), 1, utxo));
+
+		/* Undo brings back the spent coins with their original heights */
+		NO_THROW(tracker.disconnect(blocks[2].hash));
+		BOOST_REQUIRE(tracker.size() == 4 && tracker.height() == 2 && tracker.tip() == blocks[1].hash);
+		checkUtxos(tracker, "A", 0, "");
+		checkUtxos(tracker, "B", 5000, "1:1 3000 1, 3:0 2000 2");
+		checkUtxos(tracker, "C", 3800, "2:0 1000 2, 4:0 2800 2");
+
+		NO_THROW(tracker.disconnect(blocks[1].hash));
+		BOOST_REQUIRE(tracker.size() == 2 && tracker.tip() == blocks[0].hash);
+		checkUtxos(tracker, "A", 5000, "1:0 5000 1");
+		checkUtxos(tracker, "B", 3000, "1:1 3000 1");
+		checkUtxos(tracker, "C", 0, "");
+
+		/* and connecting again gives the same set */
+		NO_THROW(tracker.connect(blocks[1], 2));
+		NO_THROW(tracker.connect(blocks[2], 3));
+		BOOST_REQUIRE(tracker.size() == 3);
+		checkUtxos(tracker, "A", 4900, "5:0 4900 3");
+		checkUtxos(tracker, "C", 3800, "2:0 1000 2, 4:0 2800 2");
+	}
+
+	std::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,35 +3,335 @@
 
 #include <boost/test/unit_test.hpp>
 #include <algorithm>
-#include "main.cpp"
+#include "main.h"
+#include <raptoreumapi/hex.h>
+#include <raptoreumapi/rpcmetrics.h>
+#include <raptoreumapi/rpctrace.h>
+#include <raptoreumapi/slowcalllog.h>
 
 BOOST_AUTO_TEST_SUITE(GeneralTests)
 
-BOOST_AUTO_TEST_CASE(GetInfo) {
+BOOST_AUTO_TEST_CASE(ScanMalformed) {
+
+	std::string numbers = "[1.5,-2e3,0.00000001]";
+	JsonScanner scanner(numbers);
+	std::vector<double> values;
+
+	BOOST_REQUIRE(scanner.beginArray());
+	while(scanner.nextElement()){
+		NO_THROW(values.push_back(scanner.readDouble()));
+	}
+	BOOST_REQUIRE(values.size() == 3 && values[0] == 1.5 && values[1] == -2000 && values[2] == 0.00000001);
+
+	/* A backslash ending the input must not be stepped over */
+	const char * truncated[] = { "\"ab\\", "[\"ab\\", "{\"a\":\"\\", "[1," };
+	for(size_t i = 0; i < sizeof(truncated) / sizeof(truncated[0]); i++){
+		std::string json = truncated[i];
+		JsonScanner bad(json);
+		BOOST_REQUIRE_THROW(bad.skipValue(), RaptoreumException);
+	}
+
+	/* Numbers at the edges of int64_t and past them */
+	std::string limits = "[9223372036854775807,-9223372036854775807,92233720368.54775807,1e18]";
+	JsonScanner edges(limits);
+	BOOST_REQUIRE(edges.beginArray() && edges.nextElement());
+	BOOST_REQUIRE(edges.readInt() == 9223372036854775807LL);
+	BOOST_REQUIRE(edges.nextElement() && edges.readInt() == -9223372036854775807LL);
+	BOOST_REQUIRE(edges.nextElement() && edges.readAmount() == 9223372036854775807LL);
+	BOOST_REQUIRE(edges.nextElement() && edges.readInt() == 1000000000000000000LL);
+	BOOST_REQUIRE(!edges.nextElement() && edges.atEnd());
+
+	const char * badInts[] = { "9223372036854775808", "-99999999999999999999", "1e19", "-1e19", "1e400", "-" };
+	for(size_t i = 0; i < sizeof(badInts) / sizeof(badInts[0]); i++){
+		std::string json = badInts[i];
+		try{
+			JsonScanner(json).readInt();
+			BOOST_REQUIRE_MESSAGE(false, "integer " << json << " accepted");
+		}catch(RaptoreumException& e){
+			BOOST_REQUIRE(e.getError() == RPC_INVALID_RESPONSE);
+		}
+	}
+
+	const char * badAmounts[] = { "-", "-.5", "92233720368.54775808", "92233720368.547758075",
+	                              "99999999999999999999", "1e12", "-1e12", "1e400" };
+	for(size_t i = 0; i < sizeof(badAmounts) / sizeof(badAmounts[0]); i++){
+		std::string json = badAmounts[i];
+		try{
+			JsonScanner(json).readAmount();
+			BOOST_REQUIRE_MESSAGE(false, "amount " << json << " accepted");
+		}catch(RaptoreumException& e){
+			BOOST_REQUIRE(e.getError() == RPC_INVALID_RESPONSE);
+		}
+	}
+
+	/* Commas separate entries, exactly one between each two */
+	const char * wellFormed[] = { "[]", "{}", "[ 1 , 2 ]", "[[],[1],{}]", "{\"a\":[1,{\"b\":2}],\"c\":3}" };
+	for(size_t i = 0; i < sizeof(wellFormed) / sizeof(wellFormed[0]); i++){
+		std::string json = wellFormed[i];
+		Json::Value value;
+		JsonScanner good(json);
+		NO_THROW(good.readValue(value));
+		BOOST_REQUIRE(good.atEnd());
+	}
+
+	const char * badCommas[] = { "[1 2]", "[,1]", "[1,]", "[1,,2]", "[[1][2]]", "{\"a\":1 \"b\":2}",
+	                             "{,\"a\":1}", "{\"a\":1,}", "{\"a\":{}\"b\":2}" };
+	for(size_t i = 0; i < sizeof(badCommas) / sizeof(badCommas[0]); i++){
+		std::string json = badCommas[i];
+		Json::Value value;
+		try{
+			JsonScanner(json).readValue(value);
+			BOOST_REQUIRE_MESSAGE(false, json << " accepted");
+		}catch(RaptoreumException& e){
+			BOOST_REQUIRE(e.getError() == RPC_INVALID_RESPONSE);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(TypedErrors) {
+
+	MyFixture fx;
+
+	try{
+		fx.btc.getRawTransaction(std::string(64, 'a'), 1);
+		BOOST_REQUIRE_MESSAGE(false, "unknown txid found");
+	}catch(RaptoreumException& e){
+		BOOST_REQUIRE(e.getCode() == -5 && e.getError() == RPC_INVALID_ADDRESS_OR_KEY);
+		BOOST_REQUIRE(!e.getMessage().empty() && e.getMessage() == e.what());
+	}
+
+	try{
+		fx.btc.sendcommand("nosuchmethod", Json::Value());
+		BOOST_REQUIRE_MESSAGE(false, "unknown method called");
+	}catch(RaptoreumException& e){
+		BOOST_REQUIRE(e.getError() == RPC_METHOD_NOT_FOUND);
+	}
+
+	/* Codes without a name keep getCode() but not getError() */
+	Json::Value unnamed;
+	unnamed["code"] = 401;
+	unnamed["message"] = "Unauthorized";
+	BOOST_REQUIRE(RaptoreumException(unnamed).getCode() == 401);
+	BOOST_REQUIRE(RaptoreumException(unnamed).getError() == RPC_MISC_ERROR);
+}
+
+BOOST_AUTO_TEST_CASE(GetRpcStats) {
+
+	MyFixture fx;
+
+	NO_THROW(fx.btc.getBlockCount());
+	try{
+		fx.btc.sendcommand("nosuchmethod", Json::Value());
+	}catch(RaptoreumException& e){ }
+
+	std::vector<rpcmethodstats_t> stats = RpcMetrics::getStats();
+	std::vector<rpcmethodstats_t>::iterator it = std::find_if(stats.begin(), stats.end(),
+		[](const rpcmethodstats_t& s){ return s.method == "getblockcount"; });
+	BOOST_REQUIRE(it != stats.end());
+	BOOST_REQUIRE(it->calls >= 1 && it->roundTrips >= 1 && it->requestBytes > 0 && it->responseBytes > 0);
+
+	it = std::find_if(stats.begin(), stats.end(),
+		[](const rpcmethodstats_t& s){ return s.method == "nosuchmethod"; });
+	BOOST_REQUIRE(it != stats.end());
+	BOOST_REQUIRE(it->errors >= 1 && it->errorCodes.count(-32601) == 1);
+
+	std::string text = RpcMetrics::getPrometheusText();
+	BOOST_REQUIRE(text.find("raptoreumapi_rpc_calls_total{method=\"getblockcount\"}") != std::string::npos);
+	BOOST_REQUIRE(text.find("raptoreumapi_rpc_latency_seconds_bucket{method=\"getblockcount\",le=\"+Inf\"}") != std::string::npos);
+
+	#ifdef VERBOSE
+	std::cout << "=== rpc metrics ===" << std::endl;
+	std::cout << text << std::endl;
+	#endif
+}
+
+struct SpanRecorder : RpcTracer {
+	std::vector<rpcspan_t> spans;
+	void onSpan(const rpcspan_t& span) { spans.push_back(span); }
+};
+
+BOOST_AUTO_TEST_CASE(TraceSpans) {
+
+	MyFixture fx;
+	SpanRecorder recorder;
+
+	RpcTracer::install(&recorder);
+	try{
+		fx.btc.getBlock(fx.btc.getBestBlockHash());
+	}catch(RaptoreumException& e){
+		RpcTracer::install(NULL);
+		BOOST_REQUIRE_MESSAGE(false, e.what());
+	}
+	RpcTracer::install(NULL);
+	NO_THROW(fx.btc.getBlockCount());
+
+	BOOST_REQUIRE(recorder.spans.size() == 2);
+	BOOST_REQUIRE(recorder.spans[1].method == "getblock" && recorder.spans[1].code == 0);
+	for(size_t i = 0; i < recorder.spans.size(); ++i){
+		const rpcspan_t& span = recorder.spans[i];
+		BOOST_REQUIRE(span.transport > 0 && span.responseBytes > 0);
+		BOOST_REQUIRE(span.serialize + span.transport + span.parse + span.decode == span.total);
+	}
+
+	#ifdef VERBOSE
+	std::cout << "=== rpc spans ===" << std::endl;
+	for(size_t i = 0; i < recorder.spans.size(); ++i){
+		const rpcspan_t& span = recorder.spans[i];
+		std::cout << span.method << ": serialize " << span.serialize << " ns, transport " << span.transport
+		          << " ns, parse " << span.parse << " ns, decode " << span.decode << " ns" << std::endl;
+	}
+	std::cout << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_CASE(LogSlowCalls) {
 
 	MyFixture fx;
-	getinfo_t info;
-	
-	NO_THROW(info = fx.btc.getinfo());
-	BOOST_REQUIRE(info.protocolversion >= 70002);
+	SlowCallLog log(2, 0);
+	log.setThreshold("getblockcount", 1);
+
+	RpcTracer::install(&log);
+	for(int i = 0; i < 3; ++i){
+		try{
+			fx.btc.getBlockCount();
+		}catch(RaptoreumException& e){
+			RpcTracer::install(NULL);
+			BOOST_REQUIRE_MESSAGE(false, e.what());
+		}
+	}
+	NO_THROW(fx.btc.getBestBlockHash());
+	RpcTracer::install(NULL);
+
+	std::vector<slowcall_t> calls = log.getCalls();
+	BOOST_REQUIRE(log.getSlowCount() == 3);
+	BOOST_REQUIRE(calls.size() == 2);
+	BOOST_REQUIRE(calls[0].span.method == "getblockcount" && calls[1].span.method == "getblockcount");
+	BOOST_REQUIRE(calls[0].time <= calls[1].time);
+	BOOST_REQUIRE(calls[1].span.request.find("getblockcount") != std::string::npos);
+
+	#ifdef VERBOSE
+	std::cout << "=== slow calls ===" << std::endl;
+	std::cout << log.dump() << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_CASE(HexKernels) {
+
+	const char * simd[] = { "ssse3", "avx2" };
+	const char invalid[] = { 'g', 'G', '/', ':', '@', '`', ' ', '\xff' };
+
+	for(size_t k = 0; k < 2; k++){
+		if(!SetHexImplementation(simd[k])){
+			continue;
+		}
+
+		/* Every length around the 16 and 32 byte vector widths */
+		for(size_t len = 0; len <= 130; len++){
+			std::vector<unsigned char> data(len);
+			for(size_t i = 0; i < len; i++){
+				data[i] = (unsigned char) (i * 151 + len * 7);
+			}
+			const unsigned char * bytes = data.empty() ? NULL : &data[0];
+
+			SetHexImplementation("scalar");
+			std::string expected = HexStr(bytes, len);
+			std::string expectedReversed = HexStr(bytes, len, true);
+			SetHexImplementation(simd[k]);
+			BOOST_REQUIRE_MESSAGE(HexStr(bytes, len) == expected, simd[k] << " encode " << len);
+			BOOST_REQUIRE_MESSAGE(HexStr(bytes, len, true) == expectedReversed, simd[k] << " reversed " << len);
+
+			std::string upper = expected;
+			std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+			std::vector<unsigned char> back;
+			BOOST_REQUIRE(HexToBytes(expected, back) && back == data);
+			BOOST_REQUIRE(HexToBytes(upper, back) && back == data);
+
+			/* Odd length strings are never decoded */
+			if(len > 0){
+				BOOST_REQUIRE(!HexToBytes(expected.substr(0, 2 * len - 1), back));
+			}
+
+			/* Each position, high and low nibble, in the vector body and the tail */
+			for(size_t pos = 0; pos < 2 * len; pos++){
+				std::string bad = expected;
+				bad[pos] = invalid[pos % sizeof(invalid)];
+				BOOST_REQUIRE_MESSAGE(!HexToBytes(bad, back), simd[k] << " accepted '" << bad[pos] << "' at " << pos << " of " << len);
+			}
+		}
+	}
+
+	SetHexImplementation("");
+
+	#ifdef VERBOSE
+	std::cout << "=== hex kernels ===" << std::endl;
+	std::cout << "selected: " << HexImplementation() << std::endl << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_CASE(InjectFaults) {
+
+	/* Faults are a mock daemon feature */
+	if(liveHost()) {
+		return;
+	}
+
+	MyFixture fx;
+	std::vector<std::string> txids;
+	for(int h = 0; h < 200; h++){
+		NO_THROW(txids.push_back(fx.btc.getBlock(fx.btc.getBlockHash(h)).tx[0]));
+	}
+
+	/* Half the calls fail, each one on its own */
+	mockconfig_t config;
+	config.latency = 500;
+	config.jitter = 250;
+	config.errorRate = 0.5;
+	config.errorCode = RPC_DATABASE_ERROR;
+	MockDaemon failing(config);
+	RaptoreumAPI failingRpc("Ulysses", "Random", "http://127.0.0.1", failing.start());
+	BOOST_REQUIRE(failing.getBlockHash(199) == mockDaemon().getBlockHash(199));
+
+	std::vector<Result<getrawtransaction_t> > results;
+	NO_THROW(results = failingRpc.tryGetRawTransactions(txids, 1, 50));
+	BOOST_REQUIRE(results.size() == txids.size());
+	size_t failed = 0;
+	for(size_t i = 0; i < results.size(); i++){
+		if(results[i]){
+			BOOST_REQUIRE(results[i].value().txid == txids[i]);
+		}else{
+			BOOST_REQUIRE(results[i].error().getError() == RPC_DATABASE_ERROR);
+			failed++;
+		}
+	}
+	BOOST_REQUIRE(failed > 0 && failed < txids.size());
+
+	/* Every request goes unanswered */
+	config = mockconfig_t();
+	config.dropRate = 1;
+	MockDaemon dropping(config);
+	RaptoreumAPI droppingRpc("Ulysses", "Random", "http://127.0.0.1", dropping.start(), 2000);
+
+	std::vector<Json::Value> params(120);
+	for(int h = 0; h < 120; h++){
+		params[h].append(h);
+	}
+	try{
+		droppingRpc.sendbatch("getblockhash", params, 50, 4);
+		BOOST_REQUIRE_MESSAGE(false, "dropped batch answered");
+	}catch(RaptoreumException& e){
+		BOOST_REQUIRE(e.getError() == RPC_CONNECTION_ERROR);
+	}
+
+	NO_THROW(results = droppingRpc.tryGetRawTransactions(txids, 1, 50));
+	BOOST_REQUIRE(results.size() == txids.size());
+	for(size_t i = 0; i < results.size(); i++){
+		BOOST_REQUIRE(!results[i] && results[i].error().getError() == RPC_CONNECTION_ERROR);
+	}
 
 	#ifdef VERBOSE
-	std::cout <<  "=== getinfo ===" << std::endl;
-	std::cout << "Version: " << info.version << std::endl;
-	std::cout << "Protocol Version: " << info.protocolversion << std::endl;
-	std::cout << "Wallet Version: " << info.walletversion << std::endl;
-	std::cout << "Balance: " << info.balance << std::endl;
-	std::cout << "Blocks: " << info.blocks << std::endl;
-	std::cout << "Timeoffset: " << info.timeoffset << std::endl;
-	std::cout << "Connections: " << info.connections << std::endl;
-	std::cout << "Proxy: " << info.proxy << std::endl;
-	std::cout << "Difficulty: " << info.difficulty << std::endl;
-	std::cout << "Testnet: " << info.testnet << std::endl;
-	std::cout << "Keypoololdest: " << info.keypoololdest << std::endl;
-	std::cout << "Keypool size: " << info.keypoolsize << std::endl;
-	std::cout << "Paytxfee: " << info.paytxfee << std::endl;
-	std::cout << "Unlocked_until: " << info.unlocked_until << std::endl;
-	std::cout << "Errors: " << info.errors << std::endl << std::endl;
+	std::cout << "=== injected faults ===" << std::endl;
+	std::cout << failed << " of " << txids.size() << " calls failed" << std::endl;
+	std::cout << dropping.getRequestCount() << " requests dropped" << std::endl << std::endl;
 	#endif
 }
 
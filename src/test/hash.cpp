@@ -0,0 +1,108 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <raptoreumapi/hash.h>
+#include <raptoreumapi/hex.h>
+#include "main.h"
+
+/* Double SHA-256 of len times 'a', around the padding edges
+   (55 and 56 bytes, one block, two blocks) and beyond */
+struct hashvector_t{
+	size_t len;
+	const char * hash;
+};
+
+static const hashvector_t HASH_VECTORS[] = {
+	{ 0, "5df6e0e2761359d30a8275058e299fcc0381534545f55cf43e41983f5d4c9456" },
+	{ 1, "bf5d3affb73efd2ec6c36ad3112dd933efed63c4e1cbffcfa88e2759c144f2d8" },
+	{ 55, "566dbb7f0f129482d449b7a4b971b1302f13a1a5e1faee904a0a270b2b6f5a7d" },
+	{ 56, "122cf0fa8f81dae14842491eedeab26374370514f6c4413bcc32352ae586b39e" },
+	{ 63, "54f57e8b7d0ed00e442facf36dfa95ce6eb5df391bb7b198a4a3c728b8ba6e76" },
+	{ 64, "64d28424725a6f219efb17d6f8e4036719bf9e1a8ec2388c22cfb5fc412d46bc" },
+	{ 65, "fb183eb69ec26b94dbc6ae9ee468e26237cf006ab23823e9d58b818397ec7193" },
+	{ 119, "3ae6a2ecf88f87d2ba38220c7208d58559daf7aaef7aa800ec118eac805567c6" },
+	{ 120, "09a712ac2347b5d613f9f3ad81a4659795a8c33070346be6891417a0932092e4" },
+	{ 128, "0fb4ba94ecf6f40f31757fab9f796e26595d45f0e143b7e97e376763031da930" },
+	{ 1000, "f2b6fd3c03e69a9201ec5826310c02da24d154d2fe3c9041527696bb1f693dce" }
+};
+
+static const size_t HASH_VECTOR_COUNT = sizeof(HASH_VECTORS) / sizeof(HASH_VECTORS[0]);
+
+static const char * SHA256_KERNELS[] = { "scalar", "avx2", "shani" };
+
+BOOST_AUTO_TEST_SUITE(HashTests)
+
+BOOST_AUTO_TEST_CASE(DoubleSha256Vectors) {
+
+	std::string message(1000, 'a');
+	unsigned char hash[32];
+
+	for(size_t k = 0; k < 3; k++){
+		if(!SetSha256Implementation(SHA256_KERNELS[k])){
+			continue;
+		}
+		BOOST_REQUIRE(std::string(Sha256Implementation()) == SHA256_KERNELS[k]);
+
+		for(size_t i = 0; i < HASH_VECTOR_COUNT; i++){
+			DoubleSha256((const unsigned char *) message.data(), HASH_VECTORS[i].len, hash);
+			BOOST_REQUIRE_MESSAGE(HexStr(hash, 32) == HASH_VECTORS[i].hash,
+			                      SHA256_KERNELS[k] << " " << HASH_VECTORS[i].len << " bytes");
+		}
+
+		/* Written in pieces that straddle block boundaries */
+		unsigned char first[32];
+		Sha256 sha;
+		for(size_t done = 0; done < 1000; done += 37){
+			sha.write((const unsigned char *) message.data(), std::min((size_t) 37, 1000 - done));
+		}
+		sha.finalize(first);
+		Sha256().write(first, 32).finalize(hash);
+		BOOST_REQUIRE(HexStr(hash, 32) == HASH_VECTORS[HASH_VECTOR_COUNT - 1].hash);
+	}
+
+	SetSha256Implementation("");
+}
+
+BOOST_AUTO_TEST_CASE(DoubleSha256BatchVectors) {
+
+	std::string message(1000, 'a');
+	const unsigned char * data[2 * HASH_VECTOR_COUNT];
+	size_t lens[2 * HASH_VECTOR_COUNT];
+	unsigned char hashes[32 * 2 * HASH_VECTOR_COUNT];
+
+	/* More messages than lanes, long and short ones interleaved so lanes
+	   refill while others are still busy */
+	for(size_t i = 0; i < 2 * HASH_VECTOR_COUNT; i++){
+		const hashvector_t& vector = HASH_VECTORS[(i * 7) % HASH_VECTOR_COUNT];
+		data[i] = (const unsigned char *) message.data();
+		lens[i] = vector.len;
+	}
+
+	for(size_t k = 0; k < 3; k++){
+		if(!SetSha256Implementation(SHA256_KERNELS[k])){
+			continue;
+		}
+
+		for(size_t count = 0; count <= 2 * HASH_VECTOR_COUNT; count++){
+			DoubleSha256Batch(count, data, lens, hashes);
+			for(size_t i = 0; i < count; i++){
+				BOOST_REQUIRE_MESSAGE(HexStr(hashes + 32 * i, 32) == HASH_VECTORS[(i * 7) % HASH_VECTOR_COUNT].hash,
+				                      SHA256_KERNELS[k] << " message " << i << " of " << count);
+			}
+		}
+	}
+
+	SetSha256Implementation("");
+
+	#ifdef VERBOSE
+	std::cout << "=== sha256 kernels ===" << std::endl;
+	for(size_t k = 0; k < 3; k++){
+		std::cout << SHA256_KERNELS[k] << ": " << (SetSha256Implementation(SHA256_KERNELS[k]) ? "supported" : "unsupported") << std::endl;
+	}
+	SetSha256Implementation("");
+	std::cout << "selected: " << Sha256Implementation() << std::endl << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,66 @@
+#ifndef RAPTOREUM_API_TEST_MAIN_H
+#define RAPTOREUM_API_TEST_MAIN_H
+
+//#define VERBOSE
+
+#include <boost/test/unit_test.hpp>
+#include <raptoreumapi/raptoreumapi.h>
+#include <raptoreumapi/exception.h>
+#include <mock/mockdaemon.h>
+#include <cstdlib>
+#include <sstream>
+
+#define NO_THROW(METHOD)                    \
+  try {                                     \
+    (METHOD);                               \
+  } catch (RaptoreumException& e) {           \
+    BOOST_REQUIRE_MESSAGE(false, e.what()); \
+  }
+
+#define NO_THROW_EXCEPT(METHOD, EXCEPTION)        \
+  try {                                           \
+    (METHOD);                                     \
+  } catch (RaptoreumException& e) {                 \
+    std::stringstream err;                                        \
+    err << "Error (" << e.getCode() << "): " << e.getMessage();   \
+    BOOST_REQUIRE_MESSAGE(e.getCode() == (EXCEPTION), err.str()); \
+    BOOST_WARN_MESSAGE(false, err.str());         \
+    return;                                       \
+  }
+
+/* Tests run against an in-process mock daemon unless RAPTOREUM_RPC_HOST
+   names a live one, e.g. RAPTOREUM_RPC_HOST=127.0.0.1 */
+inline const char * liveHost() {
+	return std::getenv("RAPTOREUM_RPC_HOST");
+}
+
+inline MockDaemon& mockDaemon() {
+	static MockDaemon daemon;
+	return daemon;
+}
+
+inline int mockPort() {
+	static int port = mockDaemon().start();
+	return port;
+}
+
+struct MyFixture {
+
+	std::string username;
+	std::string password;
+	std::string address;
+	int port;
+
+	RaptoreumAPI btc;
+
+     MyFixture()
+     : username("Ulysses"),
+       password("Random"),
+       address(liveHost() ? liveHost() : "http://127.0.0.1"),
+       port(liveHost() ? 8332 : mockPort()),
+       btc(username, password, address, port)
+     { }
+     ~MyFixture() { }
+};
+
+#endif
@@ -0,0 +1,179 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <raptoreumapi/mempoolmirror.h>
+#include <raptoreumapi/transaction.h>
+#include "main.h"
+
+static const char * RAW_TX =
+		"0100000001da95ea9ded6ca4d6d47ddebf36e7f6a76992573dfd836ae46abf"
+		"12b3ac4d274b010000006b483045022100c475588d9831bc804005e28d9187"
+		"864d99804c835a638697911837cc323a83bc02205dc77df1f6e0e1723d355a"
+		"8f25cfc86919c24ab060d98e7dce4dab85e888dfa5012102f4fb3ee52627e8"
+		"2138b0227a5e95b0cb216a7080143a793f34214236856e5b3bffffffff0386"
+		"492500000000001976a9148dd5023478a002a1d3551445c3479f6f6ae611ad"
+		"88ac80f0fa02000000001976a91431fbdf399f1f95ff2801fe140f491fb18c"
+		"828fd388acec00a0a9010000001976a9146bbc6f8dcd25dfe35222e991b4a1"
+		"c3105b302aa588ac00000000";
+
+// Low digit of the index of the output the single input spends
+static const size_t SPENT_INDEX = 2 * (4 + 1 + 32) + 1;
+
+BOOST_AUTO_TEST_SUITE(MempoolTests)
+
+BOOST_AUTO_TEST_CASE(GetRawMempool) {
+
+	MyFixture fx;
+	std::vector<std::string> response;
+
+	NO_THROW(response = fx.btc.getRawMempool());
+
+	for(std::vector<std::string>::iterator it = response.begin(); it != response.end(); it++){
+		BOOST_REQUIRE((*it).size() == 64);
+	}
+
+	#ifdef VERBOSE
+	std::cout << "=== getrawmempool ===" << std::endl;
+	std::cout << "Transactions: " << response.size() << std::endl << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_CASE(MirrorMempool) {
+
+	/* Needs a mempool the test can change */
+	if(liveHost()){
+		return;
+	}
+
+	MyFixture fx;
+	MempoolMirror mirror(fx.btc);
+	NO_THROW(mirror.refresh());
+	size_t before = mirror.size();
+
+	/* Spends of distinct outputs, so they do not conflict */
+	std::vector<std::string> hexes;
+	for(char n = '2'; n <= '4'; ++n){
+		hexes.push_back(RAW_TX);
+		hexes.back()[SPENT_INDEX] = n;
+	}
+	std::vector<std::string> txids;
+	std::vector<int> errors;
+	NO_THROW(txids = fx.btc.sendRawTransactions(hexes, errors));
+	for(size_t i = 0; i < txids.size(); ++i){
+		BOOST_REQUIRE(errors[i] == 0);
+	}
+
+	size_t changes = 0;
+	NO_THROW(changes = mirror.refresh());
+	BOOST_REQUIRE(changes == txids.size() && mirror.size() == before + txids.size());
+	for(size_t i = 0; i < txids.size(); ++i){
+		mempoolentry_t entry;
+		decoderawtransaction_t tx;
+		BOOST_REQUIRE(mirror.find(txids[i], entry) && entry.size == hexes[i].size() / 2);
+		BOOST_REQUIRE(mirror.find(txids[i], tx) && tx.txid == txids[i] && tx.vout.size() == 3);
+	}
+
+	/* The first one leaves the mempool */
+	std::vector<std::string> snapshot;
+	NO_THROW(snapshot = fx.btc.getRawMempool());
+	Json::Value remaining(Json::arrayValue);
+	for(size_t i = 0; i < snapshot.size(); ++i){
+		if(snapshot[i] != txids[0]){
+			remaining.append(snapshot[i]);
+		}
+	}
+	mockDaemon().setResponse("getrawmempool", remaining);
+	NO_THROW(changes = mirror.refresh());
+	mockDaemon().clearResponses();
+
+	mempoolentry_t entry;
+	decoderawtransaction_t tx;
+	BOOST_REQUIRE(changes == 1 && mirror.size() == before + txids.size() - 1);
+	BOOST_REQUIRE(!mirror.find(txids[0], entry) && !mirror.find(txids[0], tx));
+	BOOST_REQUIRE(mirror.find(txids[1], entry) && mirror.find(txids[2], entry));
+
+	std::vector<mempoolentry_t> best = mirror.getByFeeRate(10);
+	for(size_t i = 1; i < best.size(); ++i){
+		BOOST_REQUIRE(best[i - 1].feerate >= best[i].feerate);
+	}
+
+	#ifdef VERBOSE
+	std::cout << "=== mempool mirror ===" << std::endl;
+	std::cout << "Transactions: " << mirror.size() << std::endl;
+	std::cout << "Bytes: " << mirror.bytes() << std::endl;
+	std::cout << "Fee rate for 1 MB: " << mirror.getFeeRateForBytes(1000000) << std::endl << std::endl;
+	#endif
+}
+
+BOOST_AUTO_TEST_CASE(MirrorUndecodableTransaction) {
+
+	if(liveHost()){
+		return;
+	}
+
+	MyFixture fx;
+	MempoolMirror mirror(fx.btc);
+
+	std::vector<std::string> hexes;
+	for(char n = '7'; n <= '9'; ++n){
+		hexes.push_back(RAW_TX);
+		hexes.back()[SPENT_INDEX] = n;
+	}
+	std::vector<std::string> txids;
+	std::vector<int> errors;
+	NO_THROW(txids = fx.btc.sendRawTransactions(hexes, errors));
+	BOOST_REQUIRE(txids.size() == 3 && errors[1] == 0);
+
+	/* The middle one comes back truncated within the batch */
+	Json::Value params;
+	params.append(txids[1]);
+	params.append(0);
+	mockDaemon().setResponse("getrawtransaction", params, Json::Value(hexes[1].substr(0, 100)));
+
+	std::vector<std::string> snapshot;
+	size_t changes = 0;
+	NO_THROW(snapshot = fx.btc.getRawMempool());
+	NO_THROW(changes = mirror.refresh());
+	mockDaemon().clearResponses();
+
+	decoderawtransaction_t tx;
+	BOOST_REQUIRE(changes == snapshot.size() - 1 && mirror.size() == snapshot.size() - 1);
+	BOOST_REQUIRE(mirror.find(txids[0], tx) && mirror.find(txids[2], tx));
+	BOOST_REQUIRE(!mirror.find(txids[1], tx));
+
+	/* and is picked up once it decodes */
+	NO_THROW(changes = mirror.refresh());
+	BOOST_REQUIRE(changes == 1 && mirror.find(txids[1], tx) && tx.txid == txids[1]);
+}
+
+BOOST_AUTO_TEST_CASE(MirrorAnnouncedTransactions) {
+
+	if(liveHost()){
+		return;
+	}
+
+	MyFixture fx;
+	MempoolMirror mirror(fx.btc);
+
+	/* As delivered by ZmqListener::transaction() */
+	std::vector<std::string> hexes(2, RAW_TX);
+	hexes[0][SPENT_INDEX] = '5';
+	hexes[1][SPENT_INDEX] = '6';
+	getrawtransaction_t sent, unsent;
+	DecodeRawTransaction(hexes[0], sent);
+	DecodeRawTransaction(hexes[1], unsent);
+
+	std::vector<int> errors;
+	NO_THROW(fx.btc.sendRawTransactions(std::vector<std::string>(1, hexes[0]), errors));
+	BOOST_REQUIRE(errors[0] == 0);
+
+	NO_THROW(mirror.add(sent));
+	NO_THROW(mirror.add(unsent));
+
+	decoderawtransaction_t tx;
+	BOOST_REQUIRE(mirror.find(sent.txid, tx) && tx.vin.size() == 1 && tx.vin[0].n == 5);
+	BOOST_REQUIRE(!mirror.find(unsent.txid, tx));
+	BOOST_REQUIRE(mirror.size() == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,7 +2,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <algorithm>
-#include "main.cpp"
+#include "main.h"
 
 BOOST_AUTO_TEST_SUITE(MiningTests)
 
@@ -11,7 +11,7 @@ BOOST_AUTO_TEST_CASE(GetBestBlockHash) {
 	MyFixture fx;
 	std::string response;
 
-	NO_THROW(response = fx.btc.getbestblockhash());
+	NO_THROW(response = fx.btc.getBestBlockHash());
 	BOOST_REQUIRE(response.size() == 64);
 
 	#ifdef VERBOSE
@@ -25,7 +25,7 @@ BOOST_AUTO_TEST_CASE(GetBlockHash) {
 	MyFixture fx;
 	std::string response;
 
-	NO_THROW(response = fx.btc.getblockhash(1));
+	NO_THROW(response = fx.btc.getBlockHash(1));
 	BOOST_REQUIRE(response.size() == 64);
 
 	#ifdef VERBOSE
@@ -39,7 +39,7 @@ BOOST_AUTO_TEST_CASE(GetBlockCount) {
 	MyFixture fx;
 	int response;
 
-	NO_THROW(response = fx.btc.getblockcount());
+	NO_THROW(response = fx.btc.getBlockCount());
 	BOOST_REQUIRE(response >= 10);
 
 	#ifdef VERBOSE
@@ -53,11 +53,11 @@ BOOST_AUTO_TEST_CASE(GetBlock) {
 	MyFixture fx;
 	blockinfo_t response;
 
-	NO_THROW(response = fx.btc.getblock("00000000839a8e6886ab5951d76f411475428afc90947ee320161bbf18eb6048"));
+	NO_THROW(response = fx.btc.getBlock(fx.btc.getBlockHash(1)));
 	BOOST_REQUIRE(response.height == 1);
 
 	#ifdef VERBOSE
-	std::cout << "=== getblock (10th block) ===" << std::endl;
+	std::cout << "=== getblock (1st block) ===" << std::endl;
 	std::cout << "hash: " << response.hash << std::endl;
 	std::cout << "confirmations: " << response.confirmations << std::endl;
 	std::cout << "size: " << response.size << std::endl;
@@ -80,54 +80,12 @@ BOOST_AUTO_TEST_CASE(GetBlock) {
 	#endif
 }
 
-BOOST_AUTO_TEST_CASE(GetGenerate) {
-
-	MyFixture fx;
-	bool response;
-
-	NO_THROW(response = fx.btc.getgenerate());
-	BOOST_REQUIRE(response == true || response == false);
-
-	#ifdef VERBOSE
-	std::cout << "=== getgenerate ===" << std::endl;
-	std::cout << response << std::endl << std::endl;
-	#endif
-}
-
-BOOST_AUTO_TEST_CASE(SetGenerate) {
-
-	MyFixture fx;
-
-	NO_THROW(fx.btc.setgenerate(true));
-	BOOST_REQUIRE(fx.btc.getgenerate() == true);
-
-	NO_THROW(fx.btc.setgenerate(false));
-	BOOST_REQUIRE(fx.btc.getgenerate() == false);
-}
-
-
-
-BOOST_AUTO_TEST_CASE(GetDifficulty) {
-
-	MyFixture fx;
-	double response;
-
-	NO_THROW(response = fx.btc.getdifficulty());
-	BOOST_REQUIRE(response >= 100000);
-
-	#ifdef VERBOSE
-	std::cout << "=== getdifficulty ===" << std::endl;
-	std::cout << response << std::endl << std::endl;
-	#endif
-}
-
-
 BOOST_AUTO_TEST_CASE(GetMiningInfo) {
 
 	MyFixture fx;
 	mininginfo_t response;
 
-	NO_THROW(response = fx.btc.getmininginfo());
+	NO_THROW(response = fx.btc.getMiningInfo());
 	BOOST_REQUIRE(response.blocks > 1);
 
 	#ifdef VERBOSE
@@ -146,38 +104,4 @@ BOOST_AUTO_TEST_CASE(GetMiningInfo) {
 	#endif
 }
 
-
-BOOST_AUTO_TEST_CASE(ListSinceBlock) {
-
-	MyFixture fx;
-	txsinceblock_t response;
-
-	NO_THROW(response = fx.btc.listsinceblock("", 1));
-
-	#ifdef VERBOSE
-	std::cout << "=== listsinceblock ===" << std::endl;
-	for(std::vector<transactioninfo_t>::iterator it = response.transactions.begin(); it != response.transactions.end(); it++){
-		transactioninfo_t tx = (*it);
-		std::cout << "Account: " << tx.account << std::endl;
-		std::cout << "Address: " << tx.address << std::endl;
-		std::cout << "Category: " << tx.category << std::endl;
-		std::cout << "Amount: " << tx.amount << std::endl;
-		std::cout << "Confirmations: " << tx.confirmations << std::endl;
-		std::cout << "Blockhash: " << tx.blockhash << std::endl;
-		std::cout << "Blockindex: " << tx.blockindex << std::endl;
-		std::cout << "Blocktime: " << tx.blocktime << std::endl;
-		std::cout << "Txid: " << tx.txid << std::endl;
-		std::cout << "Walletconflicts: " << std::endl;
-
-		for(std::vector<std::string>::iterator it2 = tx.walletconflicts.begin(); it2 != tx.walletconflicts.end(); it2++){
-			std::cout << "  " << (*it2) << std::endl;
-		}
-
-		std::cout << "Time: " << tx.time << std::endl;
-		std::cout << "Timereceived: " << tx.timereceived << std::endl << std::endl;
-	}
-	std::cout << "lastblock: " << response.lastblock << std::endl << std::endl;
-	#endif
-}
-
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,15 +1,12 @@
 #define BOOST_TEST_DYN_LINK
 
 #include <boost/test/unit_test.hpp>
-#include <boost/filesystem.hpp>
-#include <fstream>
+#include <raptoreumapi/transaction.h>
+#include <raptoreumapi/txbuilder.h>
+#include <raptoreumapi/payoutplanner.h>
+#include <raptoreumapi/coinselector.h>
 
-#include "main.cpp"
-
-using boost::filesystem::path;
-using boost::filesystem::exists;
-using boost::filesystem::remove;
-using boost::filesystem::current_path;
+#include "main.h"
 
 BOOST_AUTO_TEST_SUITE(RawTransactionTests)
 
@@ -18,9 +15,11 @@ BOOST_AUTO_TEST_CASE(GetRawTransactionVerbose) {
 	MyFixture fx;
 
 	getrawtransaction_t response;
-	std::string txid = "0e3e2357e806b6cdb1f70b54c3a3a17b6714ee1f0e68bebb44a74b1efd512098";
+	std::string txid;
 
-	NO_THROW(response = fx.btc.getrawtransaction(txid,1));
+	NO_THROW(txid = fx.btc.getBlock(fx.btc.getBlockHash(1)).tx[0]);
+	NO_THROW(response = fx.btc.getRawTransaction(txid, 1));
+	BOOST_REQUIRE(response.txid == txid);
 
 	#ifdef VERBOSE
 	std::cout << "=== getrawtransaction (verbose) ===" << std::endl;
@@ -61,11 +60,9 @@ BOOST_AUTO_TEST_CASE(GetRawTransactionVerbose) {
 	#endif
 }
 
-BOOST_AUTO_TEST_CASE(DecodeRawTransaction) {
-
-	MyFixture fx;
+BOOST_AUTO_TEST_CASE(DecodeRawTransactionLocally) {
 
-	decoderawtransaction_t response;
+	getrawtransaction_t response;
 	std::string rawHexTx =
 			"0100000001da95ea9ded6ca4d6d47ddebf36e7f6a76992573dfd836ae46abf"
 			"12b3ac4d274b010000006b483045022100c475588d9831bc804005e28d9187"
@@ -77,43 +74,122 @@ BOOST_AUTO_TEST_CASE(DecodeRawTransaction) {
 			"828fd388acec00a0a9010000001976a9146bbc6f8dcd25dfe35222e991b4a1"
 			"c3105b302aa588ac00000000";
 
-	NO_THROW(response = fx.btc.decoderawtransaction(rawHexTx));
+	NO_THROW(::DecodeRawTransaction(rawHexTx, response));
+	BOOST_REQUIRE(response.txid == "5a8f750129702d4e0ccd3e6fa91193d8191ea9742a36835b43d3b3c56ad816d1");
+	BOOST_REQUIRE(response.size == rawHexTx.size() / 2);
+	BOOST_REQUIRE(response.vin.size() == 1 && response.vout.size() == 3);
+	BOOST_REQUIRE(response.vin[0].txid == "4b274dacb312bf6ae46a83fd3d579269a7f6e736bfde7dd4d6a46ced9dea95da");
+	BOOST_REQUIRE(response.vin[0].n == 1);
+	BOOST_REQUIRE(response.vout[0].valueSat == 2443654);
+	BOOST_REQUIRE(response.vout[0].scriptPubKey.type == "pubkeyhash");
+	BOOST_REQUIRE(response.vout[0].scriptPubKey.addresses[0] == "RND8XfMQjb8tZ1GCKhq4fS23JX3UXDGkv5");
+
+	/* Special transaction (CbTx) with a coinbase input and an extra payload */
+	std::string cbTx =
+			"0300050001000000000000000000000000000000000000000000000000000000"
+			"0000000000ffffffff0402e80300ffffffff0100e1f505000000001976a91400"
+			"0000000000000000000000000000000000000088ac00000000060200e8030000";
+
+	NO_THROW(::DecodeRawTransaction(cbTx, response));
+	BOOST_REQUIRE(response.version == 3 && response.type == TRANSACTION_COINBASE);
+	BOOST_REQUIRE(response.vin[0].coinbase == "02e80300");
+	BOOST_REQUIRE(response.extraPayload == "0200e8030000");
+
+	BOOST_REQUIRE_THROW(::DecodeRawTransaction(cbTx.substr(0, 100), response), RaptoreumException);
+	/* Input and output counts larger than the data could hold */
+	BOOST_REQUIRE_THROW(::DecodeRawTransaction("01000000ffffffffffffffffff", response), RaptoreumException);
+	BOOST_REQUIRE_THROW(::DecodeRawTransaction("01000000fe0000ff0f00", response), RaptoreumException);
+	BOOST_REQUIRE_THROW(::DecodeRawTransaction("0100000000ffffffffffffffffff", response), RaptoreumException);
+}
 
-	#ifdef VERBOSE
-	std::cout << "=== decoderawtransaction ===" << std::endl;
-	std::cout << "Txid: " << response.txid << std::endl;
-	std::cout << "Version: " << response.version << std::endl;
-	std::cout << "Locktime: " << response.locktime << std::endl;
+BOOST_AUTO_TEST_CASE(GetRawTransactionDecoded) {
 
-	std::cout << "vin: " << std::endl;
-	for(std::vector<vin_t>::iterator it = response.vin.begin(); it != response.vin.end(); it++){
-		vin_t txin = (*it);
-		std::cout << "  txid: " << txin.txid << std::endl;
-		std::cout << "  vout: " << txin.n<< std::endl;
+	MyFixture fx;
 
-		std::cout << "  scriptSig: " << std::endl;
-		std::cout << "    asm: " << txin.scriptSig.assm << std::endl;
-		std::cout << "    hex: " << txin.scriptSig.hex << std::endl;
+	getrawtransaction_t response, expected;
+	blockinfo_t block;
+	std::string txid;
+
+	NO_THROW(block = fx.btc.getBlock(fx.btc.getBestBlockHash()));
+	txid = block.tx[0];
+
+	NO_THROW(response = fx.btc.getRawTransactionDecoded(txid));
+	NO_THROW(expected = fx.btc.getRawTransaction(txid, 1));
+
+	BOOST_REQUIRE(response.txid == expected.txid);
+	BOOST_REQUIRE(response.vin.size() == expected.vin.size());
+	BOOST_REQUIRE(response.vout.size() == expected.vout.size());
+	for(size_t i = 0; i < response.vout.size(); i++){
+		BOOST_REQUIRE(response.vout[i].scriptPubKey.hex == expected.vout[i].scriptPubKey.hex);
+		BOOST_REQUIRE(response.vout[i].scriptPubKey.addresses == expected.vout[i].scriptPubKey.addresses);
 	}
+}
 
-	std::cout << "vout: " << std::endl;
-	for(std::vector<vout_t>::iterator it = response.vout.begin(); it != response.vout.end(); it++){
-		vout_t txout = (*it);
-		std::cout << "  value: " << txout.value << std::endl;
-		std::cout << "  n: " << txout.n << std::endl;
+BOOST_AUTO_TEST_CASE(GetRawTransactionInto) {
 
-		std::cout << "  scriptPubKey" << std::endl;
-		std::cout << "    asm: " << txout.scriptPubKey.assm << std::endl;
-		std::cout << "    hex: " << txout.scriptPubKey.hex << std::endl;
-		std::cout << "    reqSigs: " << txout.scriptPubKey.reqSigs << std::endl;
-		std::cout << "    type: " << txout.scriptPubKey.type << std::endl;
+	MyFixture fx;
 
-		std::cout << "    addresses: " << std::endl;
-		for(std::vector<std::string>::iterator it2 = txout.scriptPubKey.addresses.begin(); it2 != txout.scriptPubKey.addresses.end(); it2++){
-			std::cout << "      " << (*it2) << std::endl;
-		}
+	getrawtransaction_t response, expected;
+	blockinfo_t block;
+	std::string first, second;
+
+	NO_THROW(fx.btc.getBlock(fx.btc.getBlockHash(1), block));
+	first = block.tx[0];
+	NO_THROW(fx.btc.getBlock(fx.btc.getBestBlockHash(), block));
+	second = block.tx[0];
+
+	/* The second decode reuses the inputs and outputs of the first */
+	NO_THROW(fx.btc.getRawTransaction(first, 1, response));
+	NO_THROW(fx.btc.getRawTransaction(second, 1, response));
+	NO_THROW(expected = fx.btc.getRawTransaction(second, 1));
+
+	BOOST_REQUIRE(response.txid == expected.txid && response.hex == expected.hex);
+	BOOST_REQUIRE(response.blockhash == expected.blockhash);
+	BOOST_REQUIRE(response.vin.size() == expected.vin.size());
+	BOOST_REQUIRE(response.vin[0].coinbase == expected.vin[0].coinbase);
+	BOOST_REQUIRE(response.vout.size() == expected.vout.size());
+	for(size_t i = 0; i < response.vout.size(); i++){
+		BOOST_REQUIRE(response.vout[i].valueSat == expected.vout[i].valueSat);
+		BOOST_REQUIRE(response.vout[i].scriptPubKey.addresses == expected.vout[i].scriptPubKey.addresses);
 	}
-	std::cout << std::endl;
+
+	NO_THROW(fx.btc.getRawTransactionDecoded(first, response));
+	BOOST_REQUIRE(response.txid == first && response.blockhash.empty());
+
+	NO_THROW(fx.btc.getRawTransaction(second, 0, response));
+	BOOST_REQUIRE(response.hex == expected.hex && response.vin.empty() && response.txid.empty());
+}
+
+BOOST_AUTO_TEST_CASE(TryGetRawTransaction) {
+
+	MyFixture fx;
+
+	Result<getrawtransaction_t> found, missing, decoded;
+	std::vector<Result<getrawtransaction_t> > batch;
+	blockinfo_t block;
+	std::vector<std::string> txids;
+
+	NO_THROW(block = fx.btc.getBlock(fx.btc.getBestBlockHash()));
+	txids.push_back(block.tx[0]);
+	txids.push_back(std::string(64, 'a'));
+
+	NO_THROW(found = fx.btc.tryGetRawTransaction(txids[0], 1));
+	NO_THROW(missing = fx.btc.tryGetRawTransaction(txids[1], 1));
+	NO_THROW(decoded = fx.btc.tryGetRawTransactionDecoded(txids[0]));
+	NO_THROW(batch = fx.btc.tryGetRawTransactions(txids, 1));
+
+	BOOST_REQUIRE(found && found.value().txid == txids[0]);
+	BOOST_REQUIRE(decoded && decoded.value().txid == txids[0]);
+	BOOST_REQUIRE(!missing && missing.error().getError() == RPC_INVALID_ADDRESS_OR_KEY);
+	BOOST_REQUIRE_THROW(missing.value(), RaptoreumException);
+
+	BOOST_REQUIRE(batch.size() == 2);
+	BOOST_REQUIRE(batch[0] && batch[0].value().txid == txids[0]);
+	BOOST_REQUIRE(!batch[1] && batch[1].error().getError() == RPC_INVALID_ADDRESS_OR_KEY);
+
+	#ifdef VERBOSE
+	std::cout << "=== tryGetRawTransaction ===" << std::endl;
+	std::cout << missing.error().getCode() << " " << missing.error().getMessage() << std::endl << std::endl;
 	#endif
 }
 
@@ -121,7 +197,7 @@ BOOST_AUTO_TEST_CASE(SendRawTransaction) {
 
 	MyFixture fx;
 
-	std::string txid =
+	std::string rawHexTx =
 			"0100000001da95ea9ded6ca4d6d47ddebf36e7f6a76992573dfd836ae46abf"
 			"12b3ac4d274b010000006b483045022100c475588d9831bc804005e28d9187"
 			"864d99804c835a638697911837cc323a83bc02205dc77df1f6e0e1723d355a"
@@ -132,85 +208,100 @@ BOOST_AUTO_TEST_CASE(SendRawTransaction) {
 			"828fd388acec00a0a9010000001976a9146bbc6f8dcd25dfe35222e991b4a1"
 			"c3105b302aa588ac00000000";
 
-	NO_THROW_EXCEPT(fx.btc.sendrawtransaction(txid, false), -27);
-}
+	std::vector<std::string> hexes(2, rawHexTx);
+	std::vector<std::string> response;
+	std::vector<int> errors;
 
-BOOST_AUTO_TEST_CASE(CreateRawTransaction) {
+	NO_THROW(response = fx.btc.sendRawTransactions(hexes, errors));
+	BOOST_REQUIRE(response.size() == hexes.size() && errors.size() == hexes.size());
 
-	MyFixture fx;
+	/* The same transaction is never accepted twice */
+	BOOST_REQUIRE(response[1].empty() && errors[1] != 0);
+}
 
-	txout_t tmp1 = {"32df9c334ad982c23c07eb95a597e905ad799ad7639264eaeeb009f4c7d621c7", 1};
+BOOST_AUTO_TEST_CASE(BuildRawTransaction) {
 
-	std::vector<txout_t> param1;
-	std::map<std::string,double> param2 = {{"1DvwT9U88mLKUztzrXqwZugqYFasr97oLe", 0.0001}};
-	param1.push_back(tmp1);
+	TransactionBuilder builder;
+	txout_t input = {"32df9c334ad982c23c07eb95a597e905ad799ad7639264eaeeb009f4c7d621c7", 1};
 
-	std::string response;
 	std::string expected =
 			"0100000001c721d6c7f409b0eeea649263d79a79ad05e997a595eb073cc282d"
 			"94a339cdf320100000000ffffffff0110270000000000001976a9148dd50234"
 			"78a002a1d3551445c3479f6f6ae611ad88ac00000000";
 
-	NO_THROW(response = fx.btc.createrawtransaction(param1, param2));
-	BOOST_REQUIRE(response == expected);
-}
+	NO_THROW(builder.addInput(input).addOutput("RND8XfMQjb8tZ1GCKhq4fS23JX3UXDGkv5", 10000));
+	BOOST_REQUIRE(builder.toHex() == expected);
+	BOOST_REQUIRE(builder.size() == expected.size() / 2);
 
-BOOST_AUTO_TEST_CASE(SignRawTransaction) {
-
-	MyFixture fx;
-
-	signrawtxin_t tmp1;
-	tmp1.txid = "32df9c334ad982c23c07eb95a597e905ad799ad7639264eaeeb009f4c7d621c7";
-	tmp1.n = 1;
-	tmp1.scriptPubKey = "76a914d420d8993d6266a273583adc31330cc0cf09c5c088ac";
-
-	std::string tmp2 = "KxX3UUreFY8RxFpso8g5RD9tkrn1LNgnZVtUPok23qBpzL2fgdyd";
-
-	std::string param1 =
-				"0100000001c721d6c7f409b0eeea649263d79a79ad05e997a595eb073cc282d"
-				"94a339cdf320100000000ffffffff0110270000000000001976a9148dd50234"
-				"78a002a1d3551445c3479f6f6ae611ad88ac00000000";
-	std::vector<signrawtxin_t> param2;
-	std::vector<std::string> param3;
-	param2.push_back(tmp1);
-	param3.push_back(tmp2);
+	try{
+		builder.addOutput("1DvwT9U88mLKUztzrXqwZugqYFasr97oLe", 10000);
+		BOOST_REQUIRE_MESSAGE(false, "invalid address accepted");
+	}catch(RaptoreumException& e){
+		BOOST_REQUIRE(e.getError() == RPC_INVALID_ADDRESS_OR_KEY);
+		BOOST_REQUIRE(e.getMessage() == "Invalid address 1DvwT9U88mLKUztzrXqwZugqYFasr97oLe");
+	}
+}
 
-	signrawtransaction_t response;
+BOOST_AUTO_TEST_CASE(PlanPayouts) {
 
-	NO_THROW(response = fx.btc.signrawtransaction(param1,param2,param3,"ALL"));
-	BOOST_REQUIRE(response.hex.size() >= param1.size() + 100);
-	BOOST_REQUIRE(response.complete == true);
+	PayoutPlanner planner("RND8XfMQjb8tZ1GCKhq4fS23JX3UXDGkv5", 10000);
+	std::vector<payout_t> payouts;
+	std::vector<addressutxo_t> utxos(1);
+	payoutplan_t plan;
 
+	for(int i = 0; i < 5000; i++){
+		payout_t payout = {"RDqUvHcXEhrNFtWx3xtRgEvKmXuR3pUjNc", 100000};
+		payouts.push_back(payout);
+	}
+	utxos[0].txid = "32df9c334ad982c23c07eb95a597e905ad799ad7639264eaeeb009f4c7d621c7";
+	utxos[0].outputIndex = 1;
+	utxos[0].satoshis = 100000000000LL;
+
+	/* The single UTXO funds one transaction, the size limit cuts it short */
+	NO_THROW(plan = planner.setMaxSize(50000).plan(payouts, utxos));
+	BOOST_REQUIRE(plan.transactions.size() == 1);
+	BOOST_REQUIRE(plan.transactions[0].size <= 50000);
+	BOOST_REQUIRE(plan.transactions[0].payouts.size() + plan.unplanned.size() == payouts.size());
+	BOOST_REQUIRE(plan.transactions[0].fee >= (int64_t) plan.transactions[0].size * 10);
+
+	/* Change to a Bitcoin address is refused up front */
+	try{
+		PayoutPlanner bad("1DvwT9U88mLKUztzrXqwZugqYFasr97oLe", 10000);
+		BOOST_REQUIRE_MESSAGE(false, "invalid change address accepted");
+	}catch(RaptoreumException& e){
+		BOOST_REQUIRE(e.getError() == RPC_INVALID_ADDRESS_OR_KEY);
+	}
 }
 
-BOOST_AUTO_TEST_CASE(GetRawMempool) {
+BOOST_AUTO_TEST_CASE(SelectCoins) {
 
-	MyFixture fx;
+	std::vector<int64_t> amounts;
+	for(int i = 0; i < 100000; i++){
+		amounts.push_back(100000 + (i * 7919LL) % 100000000);
+	}
+	amounts.push_back(123456789 + 1480);
 
-	std::vector<std::string> response;
-	NO_THROW(response = fx.btc.getrawmempool());
-	BOOST_REQUIRE(response.size() >= 0);
+	CoinSelector selector(amounts, 10000);
+	coinselection_t selection;
 
-	#ifdef VERBOSE
-	std::cout << "=== getrawmempool ===" << std::endl;
-	for(std::vector<std::string>::iterator it = response.begin(); it != response.end(); it++){
-		std::cout << *it << std::endl;
-	}
-	std::cout << std::endl;
-	#endif
-}
+	/* An exact match needs no change */
+	BOOST_REQUIRE(selector.selectBranchAndBound(123456789, 0, selection));
+	BOOST_REQUIRE(selection.selected.size() == 1);
+	BOOST_REQUIRE(selection.selected[0] == amounts.size() - 1);
+	BOOST_REQUIRE(selection.value - selection.fee == 123456789);
 
-BOOST_AUTO_TEST_CASE(GetRawChangeAddress) {
+	NO_THROW(selector.select(5000000000LL, 5000, selection));
+	BOOST_REQUIRE(selection.value - selection.fee >= 5000000000LL);
 
-	MyFixture fx;
+	BOOST_REQUIRE(selector.selectKnapsack(77777, selection));
+	BOOST_REQUIRE(selection.value - selection.fee >= 77777);
 
-	std::string response;
-	NO_THROW_EXCEPT(response = fx.btc.getrawchangeaddress(), -12);
-	BOOST_REQUIRE(response.size() >= 27 && response.size() <= 34);
+	BOOST_REQUIRE(!selector.selectLargestFirst(selector.getAvailable() + 1, selection));
 
 	#ifdef VERBOSE
-	std::cout << "=== getrawchangeaddress ===" << std::endl;
-	std::cout << response << std::endl << std::endl;
+	std::cout << "=== selectcoins ===" << std::endl;
+	std::cout << selection.strategy << ": " << selection.selected.size() << " inputs, "
+	          << selection.value << " sat" << std::endl << std::endl;
 	#endif
 }
 
@@ -0,0 +1,186 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "main.h"
+
+#ifdef HAVE_ZMQ
+
+#include <raptoreumapi/zmqsubscriber.h>
+#include <raptoreumapi/transaction.h>
+#include <raptoreumapi/hex.h>
+#include <zmq.h>
+
+static std::string bytes(const std::string& hex) {
+	std::vector<unsigned char> out;
+	BOOST_REQUIRE(HexToBytes(hex, out));
+	return std::string(out.begin(), out.end());
+}
+
+/* Stands in for the daemon's -zmqpub* publisher, on an ephemeral port */
+struct PublisherFixture {
+
+	void * context;
+	void * socket;
+	std::string endpoint;
+
+	PublisherFixture()
+	: context(zmq_ctx_new()),
+	  socket(zmq_socket(context, ZMQ_PUB))
+	{
+		int linger = 0;
+		char bound[256];
+		size_t size = sizeof(bound);
+		zmq_setsockopt(socket, ZMQ_LINGER, &linger, sizeof(linger));
+		BOOST_REQUIRE(zmq_bind(socket, "tcp://127.0.0.1:*") == 0);
+		BOOST_REQUIRE(zmq_getsockopt(socket, ZMQ_LAST_ENDPOINT, bound, &size) == 0);
+		endpoint = bound;
+	}
+
+	~PublisherFixture() {
+		zmq_close(socket);
+		zmq_ctx_term(context);
+	}
+
+	void publish(const std::string& topic, const std::string& body, unsigned int sequence) {
+		unsigned char seq[4] = { (unsigned char) sequence, (unsigned char) (sequence >> 8),
+		                         (unsigned char) (sequence >> 16), (unsigned char) (sequence >> 24) };
+		zmq_send(socket, topic.data(), topic.size(), ZMQ_SNDMORE);
+		zmq_send(socket, body.data(), body.size(), ZMQ_SNDMORE);
+		zmq_send(socket, seq, sizeof(seq), 0);
+	}
+};
+
+struct RecordingListener: ZmqListener {
+	std::vector<zmqnotification_t> received;
+	std::vector<rawblock_t> blocks;
+	std::vector<decoderawtransaction_t> txs;
+	std::vector<unsigned int> gaps;
+
+	void notification(const zmqnotification_t& notification) { received.push_back(notification); }
+	void block(const rawblock_t& block) { blocks.push_back(block); }
+	void transaction(const decoderawtransaction_t& tx) { txs.push_back(tx); }
+	void gap(const std::string& topic, unsigned int missed) { gaps.push_back(missed); }
+
+	bool empty() const { return received.empty() && blocks.empty() && txs.empty(); }
+	void clear() { received.clear(); blocks.clear(); txs.clear(); gaps.clear(); }
+};
+
+/* Late joiners miss messages sent before the subscription is active, so
+   publish until one gets through, drain the copies still queued and
+   start the test from a clean sequence state */
+static void warmUp(PublisherFixture& pub, ZmqSubscriber& sub, RecordingListener& listener,
+                   const std::string& topic, const std::string& body) {
+	while(listener.empty()) {
+		pub.publish(topic, body, 0);
+		sub.poll(100);
+	}
+	while(sub.poll(100)) { }
+	sub.reset();
+	listener.clear();
+}
+
+static const char * RAW_TX =
+		"0100000001da95ea9ded6ca4d6d47ddebf36e7f6a76992573dfd836ae46abf"
+		"12b3ac4d274b010000006b483045022100c475588d9831bc804005e28d9187"
+		"864d99804c835a638697911837cc323a83bc02205dc77df1f6e0e1723d355a"
+		"8f25cfc86919c24ab060d98e7dce4dab85e888dfa5012102f4fb3ee52627e8"
+		"2138b0227a5e95b0cb216a7080143a793f34214236856e5b3bffffffff0386"
+		"492500000000001976a9148dd5023478a002a1d3551445c3479f6f6ae611ad"
+		"88ac80f0fa02000000001976a91431fbdf399f1f95ff2801fe140f491fb18c"
+		"828fd388acec00a0a9010000001976a9146bbc6f8dcd25dfe35222e991b4a1"
+		"c3105b302aa588ac00000000";
+
+BOOST_AUTO_TEST_SUITE(ZmqTests)
+
+BOOST_AUTO_TEST_CASE(ReceiveNotifications) {
+
+	PublisherFixture pub;
+	RecordingListener listener;
+	ZmqSubscriber sub(pub.endpoint, listener);
+	sub.subscribe("hashblock");
+
+	std::string hash(32, '\xab');
+	warmUp(pub, sub, listener, "hashblock", hash);
+
+	pub.publish("hashtx", hash, 1);
+	pub.publish("hashblock", hash, 8);
+	BOOST_REQUIRE(sub.poll(1000));
+
+	BOOST_REQUIRE(listener.received.size() == 1);
+	BOOST_REQUIRE(listener.received[0].topic == "hashblock");
+	std::string hex;
+	for(int i = 0; i < 32; ++i) {
+		hex += "ab";
+	}
+	BOOST_REQUIRE(listener.received[0].hex == hex);
+	BOOST_REQUIRE(listener.received[0].sequence == 8);
+	BOOST_REQUIRE(listener.gaps.empty());
+}
+
+BOOST_AUTO_TEST_CASE(DetectSequenceGap) {
+
+	PublisherFixture pub;
+	RecordingListener listener;
+	ZmqSubscriber sub(pub.endpoint, listener);
+	sub.subscribe("rawtx");
+
+	getrawtransaction_t expected;
+	DecodeRawTransaction(RAW_TX, expected);
+	warmUp(pub, sub, listener, "rawtx", bytes(RAW_TX));
+
+	pub.publish("rawtx", bytes(RAW_TX), 1);
+	BOOST_REQUIRE(sub.poll(1000));
+
+	/* Sequence numbers 2 to 4 never arrive */
+	pub.publish("rawtx", bytes(RAW_TX), 5);
+	BOOST_REQUIRE(sub.poll(1000));
+
+	BOOST_REQUIRE(listener.gaps.size() == 1);
+	BOOST_REQUIRE(listener.gaps[0] == 3);
+	BOOST_REQUIRE(listener.txs.size() == 2);
+	BOOST_REQUIRE(listener.txs.back().txid == expected.txid);
+	BOOST_REQUIRE(listener.txs.back().vout.size() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(CatchUpMissedBlocks) {
+
+	/* Needs blocks the test can publish itself */
+	if(liveHost()) {
+		return;
+	}
+
+	MyFixture fx;
+	PublisherFixture pub;
+	RecordingListener listener;
+	ZmqSubscriber sub(pub.endpoint, listener, fx.btc);
+	sub.subscribe("rawblock");
+
+	std::vector<std::string> hashes, raw;
+	for(int height = 5; height <= 9; ++height) {
+		Json::Value params;
+		NO_THROW(hashes.push_back(fx.btc.getBlockHash(height)));
+		params.append(hashes.back());
+		params.append(false);
+		NO_THROW(raw.push_back(fx.btc.sendcommand("getblock", params).asString()));
+	}
+
+	warmUp(pub, sub, listener, "rawblock", bytes(raw[0]));
+
+	pub.publish("rawblock", bytes(raw[0]), 1);
+	BOOST_REQUIRE(sub.poll(1000));
+
+	/* Blocks 6 to 8 are missed and fetched over RPC */
+	pub.publish("rawblock", bytes(raw[4]), 5);
+	BOOST_REQUIRE(sub.poll(1000));
+
+	BOOST_REQUIRE(listener.gaps.size() == 1);
+	BOOST_REQUIRE(listener.blocks.size() == hashes.size());
+	for(size_t i = 0; i < hashes.size(); ++i) {
+		BOOST_REQUIRE(listener.blocks[i].hash == hashes[i]);
+		BOOST_REQUIRE(listener.blocks[i].tx.size() == 1);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,291 @@
+/**
+ * @file    loadgen.cpp
+ * @author  Laura Mejía
+ * @date    18.10.2026
+ * @version 1.0
+ *
+ * Load generator driving a weighted mix of calls against a
+ * daemon or the mock from several connections, closed loop
+ * or at a fixed rate, reporting throughput and latency
+ * percentiles per call.
+ */
+
+#include <mock/mockdaemon.h>
+#include <raptoreumapi/raptoreumapi.h>
+#include <raptoreumapi/exception.h>
+#include <raptoreumapi/histogram.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+enum call_t{
+	CALL_GETRAWTRANSACTION,
+	CALL_GETADDRESSBALANCE,
+	CALL_GETADDRESSTXS,
+	CALL_GETMININGINFO,
+	CALL_COUNT
+};
+
+static const char * CALL_NAMES[CALL_COUNT] = {
+	"getRawTransaction", "getAddressBalance", "getAddressTxs", "getMiningInfo"
+};
+
+struct options_t{
+	std::string host;
+	int port;
+	std::string user;
+	std::string password;
+	bool mock;
+	unsigned int threads;
+	double duration;            // seconds
+	double rate;                // calls per second over all threads, 0 for closed loop
+	unsigned int weights[CALL_COUNT];
+	std::vector<std::string> txids;
+	std::vector<std::string> addresses;
+};
+
+/* Per thread results, merged at the end */
+struct stats_t{
+	Histogram latency[CALL_COUNT];
+	uint64_t errors[CALL_COUNT];
+
+	stats_t() : errors() { }
+};
+
+static std::vector<std::string> split(const std::string& list){
+	std::vector<std::string> ret;
+	std::stringstream ss(list);
+	std::string item;
+	while(std::getline(ss, item, ',')){
+		if(!item.empty()){
+			ret.push_back(item);
+		}
+	}
+	return ret;
+}
+
+static bool parseMix(const std::string& mix, unsigned int weights[CALL_COUNT]){
+	std::fill(weights, weights + CALL_COUNT, 0);
+	std::vector<std::string> items = split(mix);
+	for(size_t i = 0; i < items.size(); ++i){
+		size_t colon = items[i].find(':');
+		std::string name = items[i].substr(0, colon);
+		int c = 0;
+		while(c < CALL_COUNT && name != CALL_NAMES[c]){
+			++c;
+		}
+		if(c == CALL_COUNT){
+			return false;
+		}
+		weights[c] = (colon == std::string::npos) ? 1 : std::strtoul(items[i].c_str() + colon + 1, NULL, 10);
+	}
+	return true;
+}
+
+static void usage(){
+	std::fprintf(stderr,
+		"Usage: raptoreumapi_loadgen [options]\n"
+		"  -host=<host>           Daemon host, may name the scheme (default: http://127.0.0.1)\n"
+		"  -port=<port>           Daemon port (default: 8332)\n"
+		"  -user=<user> -password=<pw>\n"
+		"  -mock                  Run against an in-process mock daemon instead\n"
+		"  -threads=<n>           Connections, one thread each (default: 4)\n"
+		"  -duration=<s>          Length of the run (default: 10)\n"
+		"  -rate=<calls/s>        Open loop at this total rate; 0 sends back to back (default: 0)\n"
+		"  -mix=<call:weight,..>  Default: getRawTransaction:4,getAddressBalance:2,\n"
+		"                         getAddressTxs:1,getMiningInfo:1\n"
+		"  -txids=<txid,..>       Transactions to ask for (default: those of the tip block)\n"
+		"  -addresses=<addr,..>   Addresses to ask for (default: receivers in the tip block)\n");
+}
+
+/* Takes the txids and receiving addresses of the tip block */
+static void discover(RaptoreumAPI& btc, options_t& options){
+	blockinfo_t tip = btc.getBlock(btc.getBestBlockHash());
+
+	if(options.txids.empty()){
+		options.txids = tip.tx;
+	}
+	for(size_t i = 0; i < tip.tx.size() && options.addresses.empty() && i < 100; ++i){
+		getrawtransaction_t tx = btc.getRawTransaction(tip.tx[i], 1);
+		for(size_t j = 0; j < tx.vout.size(); ++j){
+			if(!tx.vout[j].scriptPubKey.addresses.empty()){
+				options.addresses.push_back(tx.vout[j].scriptPubKey.addresses[0]);
+			}
+		}
+	}
+}
+
+/*
+ * In open loop every thread has a schedule of send times. Latency is
+ * measured from the scheduled time, not from when the call could be
+ * sent, so a slow daemon shows up as latency instead of as a lower rate.
+ */
+static void worker(const options_t& options, RaptoreumAPI& btc, unsigned int seed,
+                   Clock::time_point start, Clock::time_point end, stats_t& stats){
+	std::mt19937 random(seed);
+	std::discrete_distribution<int> pick(options.weights, options.weights + CALL_COUNT);
+	std::chrono::nanoseconds interval(0);
+	if(options.rate > 0){
+		interval = std::chrono::nanoseconds((long long) (1e9 * options.threads / options.rate));
+	}
+
+	/* Spread the threads' schedules over one interval */
+	Clock::time_point scheduled = start + interval * (seed % options.threads) / options.threads;
+
+	while(true){
+		if(options.rate > 0){
+			std::this_thread::sleep_until(scheduled);
+		}else{
+			scheduled = Clock::now();
+		}
+		if(scheduled >= end){
+			break;
+		}
+
+		int call = pick(random);
+		try{
+			switch(call){
+			case CALL_GETRAWTRANSACTION:
+				btc.getRawTransaction(options.txids[random() % options.txids.size()], 1);
+				break;
+			case CALL_GETADDRESSBALANCE:
+				btc.getAddressBalance(options.addresses[random() % options.addresses.size()]);
+				break;
+			case CALL_GETADDRESSTXS:
+				btc.getAddressTxs(options.addresses[random() % options.addresses.size()]);
+				break;
+			case CALL_GETMININGINFO:
+				btc.getMiningInfo();
+				break;
+			}
+			stats.latency[call].record(
+				std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - scheduled).count());
+		}
+		catch(RaptoreumException& e){
+			++stats.errors[call];
+		}
+
+		scheduled += interval;
+	}
+}
+
+static void report(const char * name, const Histogram& latency, uint64_t errors, double seconds){
+	std::printf("%-18s %10llu %8llu %10.1f %10lld %10lld %10lld %10lld\n", name,
+	            (unsigned long long) latency.count(), (unsigned long long) errors, latency.count() / seconds,
+	            (long long) latency.percentile(50), (long long) latency.percentile(99),
+	            (long long) latency.percentile(99.9), (long long) latency.max());
+}
+
+int main(int argc, char * argv[]){
+	options_t options;
+	options.host = "http://127.0.0.1";
+	options.port = 8332;
+	options.mock = false;
+	options.threads = 4;
+	options.duration = 10;
+	options.rate = 0;
+	parseMix("getRawTransaction:4,getAddressBalance:2,getAddressTxs:1,getMiningInfo:1", options.weights);
+
+	for(int i = 1; i < argc; ++i){
+		std::string arg = argv[i];
+		size_t eq = arg.find('=');
+		std::string name = arg.substr(0, eq);
+		std::string value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+
+		if(name == "-host") options.host = value;
+		else if(name == "-port") options.port = std::atoi(value.c_str());
+		else if(name == "-user") options.user = value;
+		else if(name == "-password") options.password = value;
+		else if(name == "-mock") options.mock = true;
+		else if(name == "-threads") options.threads = std::max(1, std::atoi(value.c_str()));
+		else if(name == "-duration") options.duration = std::atof(value.c_str());
+		else if(name == "-rate") options.rate = std::atof(value.c_str());
+		else if(name == "-txids") options.txids = split(value);
+		else if(name == "-addresses") options.addresses = split(value);
+		else if(name == "-mix" && parseMix(value, options.weights)) continue;
+		else{
+			usage();
+			return 1;
+		}
+	}
+
+	try{
+		std::unique_ptr<MockDaemon> daemon;
+		if(options.mock){
+			daemon.reset(new MockDaemon());
+			options.host = "http://127.0.0.1";
+			options.port = daemon->start();
+		}
+
+		std::vector<std::unique_ptr<RaptoreumAPI> > connections;
+		for(unsigned int t = 0; t < options.threads; ++t){
+			connections.push_back(std::unique_ptr<RaptoreumAPI>(
+				new RaptoreumAPI(options.user, options.password, options.host, options.port)));
+		}
+
+		discover(*connections[0], options);
+		if(options.txids.empty() || options.addresses.empty()){
+			std::fprintf(stderr, "Error: no txids or addresses to ask for, pass -txids and -addresses\n");
+			return 1;
+		}
+
+		std::printf("%u threads, %s, %.0f s\n", options.threads,
+		            options.rate > 0 ? (std::to_string((long long) options.rate) + " calls/s").c_str() : "closed loop",
+		            options.duration);
+
+		std::vector<stats_t> stats(options.threads);
+		std::vector<std::thread> workers;
+		Clock::time_point start = Clock::now();
+		Clock::time_point end = start + std::chrono::microseconds((long long) (options.duration * 1e6));
+
+		for(unsigned int t = 0; t < options.threads; ++t){
+			workers.push_back(std::thread(worker, std::cref(options), std::ref(*connections[t]), t,
+			                              start, end, std::ref(stats[t])));
+		}
+		for(size_t t = 0; t < workers.size(); ++t){
+			workers[t].join();
+		}
+		double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		/* Latencies in microseconds */
+		Histogram all;
+		uint64_t allErrors = 0;
+		std::printf("%-18s %10s %8s %10s %10s %10s %10s %10s\n",
+		            "call", "count", "errors", "calls/s", "p50 us", "p99 us", "p999 us", "max us");
+		for(int c = 0; c < CALL_COUNT; ++c){
+			Histogram latency;
+			uint64_t errors = 0;
+			for(size_t t = 0; t < stats.size(); ++t){
+				latency.merge(stats[t].latency[c]);
+				errors += stats[t].errors[c];
+			}
+			if(options.weights[c] > 0){
+				report(CALL_NAMES[c], latency, errors, seconds);
+			}
+			all.merge(latency);
+			allErrors += errors;
+		}
+		report("all", all, allErrors, seconds);
+	}
+	catch(RaptoreumException& e){
+		std::fprintf(stderr, "Error (%d): %s\n", e.getCode(), e.getMessage().c_str());
+		return 1;
+	}
+	catch(std::exception& e){
+		std::fprintf(stderr, "Error: %s\n", e.what());
+		return 1;
+	}
+
+	return 0;
+}